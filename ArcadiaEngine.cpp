@@ -15,6 +15,39 @@
 #include <set>
 #include <utility>
 #include <tuple>
+#include <memory>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <cstdint>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ARCADIA_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define ARCADIA_PREFETCH(addr) __builtin_prefetch(addr)
+#endif
 
 using namespace std;
 
@@ -24,260 +57,3643 @@ using namespace std;
 
 // --- 1. PlayerTable (Double Hashing) ---
 
+// Keys resolved together by the batched lookups; enough to cover memory
+// latency without the per-key state spilling out of L1
+static const int BATCH_WINDOW = 16;
+
+// Default batch operations for engines without a specialized path
+void PlayerTable::insertBatch(const vector<pair<int, string>>& entries) {
+    for (const auto& entry : entries) {
+        insert(entry.first, entry.second);
+    }
+}
+
+double PlayerTable::tombstoneRatio() {
+    return 0.0;
+}
+
+void PlayerTable::saveSnapshot(const string& path) {
+    throw "Snapshot not supported";
+}
+
+PlayerTableStats PlayerTable::stats() {
+    return PlayerTableStats();
+}
+
+vector<int> PlayerTable::searchByName(const string& name) {
+    throw "Name index not enabled";
+}
+
+void PlayerTable::insertWithTTL(int playerID, const string& name, long long ttl) {
+    throw "TTL not supported";
+}
+
+void PlayerTable::advanceTime(long long ticks) {
+    throw "TTL not supported";
+}
+
+void PlayerTable::searchBatch(const vector<int>& playerIDs, vector<string_view>& results) {
+    results.resize(playerIDs.size());
+    for (size_t i = 0; i < playerIDs.size(); i++) {
+        results[i] = searchView(playerIDs[i]);
+    }
+}
+
+// Bump allocator that owns the bytes of every stored player name. Names are
+// written once and never move, so tables hand out string_views into it.
+// Released names (renames, removes, expiry) are only counted as waste.
+// Owners check needsCompaction() after every release() and then rebuild
+// the arena from their live names, so it stays within about twice the
+// live bytes plus a block.
+class NameArena {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    vector<unique_ptr<char[]>> blocks;
+    size_t blockUsed = 0;
+    size_t blockCapacity = 0;
+    size_t reserved = 0;  // Sum of block capacities
+    size_t liveBytes = 0;
+    size_t wasted = 0;
+
+public:
+    string_view intern(string_view s) {
+        if (s.empty()) return string_view();
+        if (blockUsed + s.size() > blockCapacity) {
+            blockCapacity = max(BLOCK_SIZE, s.size());
+            blocks.emplace_back(new char[blockCapacity]);
+            blockUsed = 0;
+            reserved += blockCapacity;
+        }
+        char* dest = blocks.back().get() + blockUsed;
+        memcpy(dest, s.data(), s.size());
+        blockUsed += s.size();
+        liveBytes += s.size();
+        return string_view(dest, s.size());
+    }
+
+    // Mark a previously interned name as no longer referenced
+    void release(string_view s) {
+        liveBytes -= s.size();
+        wasted += s.size();
+    }
+
+    bool needsCompaction() const {
+        return wasted > BLOCK_SIZE && wasted > liveBytes;
+    }
+
+    size_t reservedBytes() const {
+        return reserved;
+    }
+
+    void swap(NameArena& other) {
+        blocks.swap(other.blocks);
+        std::swap(blockUsed, other.blockUsed);
+        std::swap(blockCapacity, other.blockCapacity);
+        std::swap(reserved, other.reserved);
+        std::swap(liveBytes, other.liveBytes);
+        std::swap(wasted, other.wasted);
+    }
+};
+
+// Hierarchical timer wheel keyed by playerID. Level L has 64 slots of
+// 64^L ticks each, so four levels cover 2^24 ticks; later deadlines wait in
+// an overflow list that is re-filed every 2^24 ticks. A timer is filed at
+// the lowest level whose slot it has not reached yet and is cascaded one
+// level down each time the clock enters its slot, so every timer is touched
+// at most once per level before it fires. The wheel tracks each player's
+// current deadline: rescheduled or cancelled timers stay filed but are
+// dropped when their slot drains, and advance() jumps over empty slots.
+class TimerWheel {
+public:
+    struct Timer {
+        int playerID;
+        long long deadline;
+    };
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int HORIZON_BITS = LEVELS * SLOT_BITS;
+
+    vector<Timer> slots[LEVELS][SLOTS];
+    vector<Timer> overflow;
+    long long now = 0;
+    long long filed = 0;             // Timers in slots, including stale ones
+    unordered_map<int, long long> live;  // playerID -> current deadline
+
+    // Timers cascaded in the tick they are due land in the level-0 slot
+    // about to be drained, so a deadline of `now` is still honored
+    void file(const Timer& timer) {
+        long long deadline = max(timer.deadline, now);
+        for (int level = 0; level < LEVELS; level++) {
+            int shift = SLOT_BITS * (level + 1);
+            // Same higher-level granule as now: the slot is still ahead of us
+            if ((deadline >> shift) == (now >> shift)) {
+                slots[level][(deadline >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(timer);
+                return;
+            }
+        }
+        overflow.push_back(timer);
+    }
+
+    // Re-file the timers of the level slot the clock just entered
+    void cascade(vector<Timer>& bucket) {
+        vector<Timer> moving;
+        moving.swap(bucket);
+        for (const Timer& timer : moving) {
+            file(timer);
+        }
+    }
+
+public:
+    long long currentTime() const {
+        return now;
+    }
+
+    // Replaces any earlier timer of the same player
+    void schedule(int playerID, long long deadline) {
+        Timer timer{ playerID, max(deadline, now + 1) };
+        live[playerID] = timer.deadline;
+        file(timer);
+        filed++;
+    }
+
+    void cancel(int playerID) {
+        live.erase(playerID);
+    }
+
+    // Advance the clock by one tick and append every timer due by then
+    void tick(vector<Timer>& expired) {
+        now++;
+        if ((now & ((1LL << HORIZON_BITS) - 1)) == 0) {
+            cascade(overflow);
+        }
+        // Cascade from the highest boundary crossed downwards, so timers
+        // dropping several levels at once are handled in this same tick
+        int top = 0;
+        while (top + 1 < LEVELS && (now & ((1LL << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+            top++;
+        }
+        for (int level = top; level >= 1; level--) {
+            cascade(slots[level][(now >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+        }
+
+        vector<Timer>& due = slots[0][now & (SLOTS - 1)];
+        for (const Timer& timer : due) {
+            auto it = live.find(timer.playerID);
+            if (it != live.end() && it->second == timer.deadline) {
+                expired.push_back(timer);
+                live.erase(it);
+            }
+        }
+        filed -= (long long)due.size();
+        due.clear();
+    }
+
+    // Earliest tick after now that drains or cascades a non-empty slot.
+    // Slots behind the clock at every level are empty, and each level's
+    // slots ahead start before any slot ahead at the level above.
+    long long nextEventTime() const {
+        for (int level = 0; level < LEVELS; level++) {
+            int shift = SLOT_BITS * level;
+            long long granule = (now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            for (int index = (int)((now >> shift) & (SLOTS - 1)) + 1; index < SLOTS; index++) {
+                if (!slots[level][index].empty()) {
+                    return granule + ((long long)index << shift);
+                }
+            }
+        }
+        if (!overflow.empty()) {
+            return ((now >> HORIZON_BITS) + 1) << HORIZON_BITS;
+        }
+        return LLONG_MAX;
+    }
+
+    // Advance by `ticks`, jumping between the ticks that have work. Once no
+    // timer is live, stale ones are discarded and the clock moves straight
+    // to the target.
+    void advance(long long ticks, vector<Timer>& expired) {
+        long long target = now + ticks;
+        while (now < target) {
+            if (live.empty()) {
+                if (filed > 0) {
+                    for (auto& level : slots) {
+                        for (auto& slot : level) slot.clear();
+                    }
+                    overflow.clear();
+                    filed = 0;
+                }
+                now = target;
+                break;
+            }
+            long long next = nextEventTime();
+            if (next > target) {
+                now = target;
+                break;
+            }
+            now = next - 1;
+            tick(expired);
+        }
+    }
+};
+
+// On-disk PlayerTable snapshot: header, `capacity` slots laid out exactly as
+// ConcretePlayerTable probes them (no tombstones), then the name blob that
+// slot offsets point into. Fields are native-endian fixed-width integers so
+// the file can be mapped and read in place.
+static const char PLAYER_SNAPSHOT_MAGIC[8] = { 'A', 'R', 'C', 'P', 'T', 'B', 'L', '1' };
+
+struct PlayerSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t resizable;
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t blobSize;
+};
+
+struct PlayerSnapshotSlot {
+    int32_t playerID;
+    uint32_t occupied;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+
+static void writePlayerSnapshot(const string& path, bool resizable, int count,
+                                const vector<PlayerSnapshotSlot>& slots, const string& blob) {
+    PlayerSnapshotHeader header;
+    memcpy(header.magic, PLAYER_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = 1;
+    header.resizable = resizable ? 1 : 0;
+    header.capacity = (uint32_t)slots.size();
+    header.count = (uint32_t)count;
+    header.blobSize = blob.size();
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        throw "Cannot write snapshot";
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(PlayerSnapshotSlot));
+    out.write(blob.data(), blob.size());
+    if (!out) {
+        throw "Cannot write snapshot";
+    }
+}
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+public:
+    MappedFile(const string& path) {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw "Cannot open snapshot";
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        length = (size_t)fileSize.QuadPart;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!data) {
+            close();
+            throw "Cannot map snapshot";
+        }
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw "Cannot open snapshot";
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close();
+            throw "Cannot map snapshot";
+        }
+        length = (size_t)info.st_size;
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close();
+            throw "Cannot map snapshot";
+        }
+        data = static_cast<const char*>(mapped);
+#endif
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* bytes() const { return data; }
+    size_t size() const { return length; }
+
+    void close() {
+#if defined(_WIN32)
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data) munmap(const_cast<char*>(data), length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        data = nullptr;
+        length = 0;
+    }
+};
+
+// Compile with -DARCADIA_TABLE_STATS=0 to drop per-operation probe counting
+#ifndef ARCADIA_TABLE_STATS
+#define ARCADIA_TABLE_STATS 1
+#endif
+
+static const int PROBE_HISTOGRAM_BUCKETS = 16;
+static const int CLUSTER_HISTOGRAM_BUCKETS = 16;
+
+#if ARCADIA_TABLE_STATS
+// Running probe counts for one kind of operation
+struct ProbeCounters {
+    long long operations = 0;
+    long long probes = 0;
+    int maxProbes = 0;
+    long long histogram[PROBE_HISTOGRAM_BUCKETS] = {};
+
+    void record(int count) {
+        operations++;
+        probes += count;
+        maxProbes = max(maxProbes, count);
+        histogram[min(max(count, 1), PROBE_HISTOGRAM_BUCKETS) - 1]++;
+    }
+};
+
+static void fillProbeStats(PlayerTableStats& stats, const ProbeCounters& inserts,
+                           const ProbeCounters& searches) {
+    stats.insertOps = inserts.operations;
+    stats.avgInsertProbes = inserts.operations ? (double)inserts.probes / inserts.operations : 0.0;
+    stats.maxInsertProbes = inserts.maxProbes;
+    stats.searchOps = searches.operations;
+    stats.avgSearchProbes = searches.operations ? (double)searches.probes / searches.operations : 0.0;
+    stats.maxSearchProbes = searches.maxProbes;
+    stats.probeHistogram.assign(PROBE_HISTOGRAM_BUCKETS, 0);
+    for (int i = 0; i < PROBE_HISTOGRAM_BUCKETS; i++) {
+        stats.probeHistogram[i] = inserts.histogram[i] + searches.histogram[i];
+    }
+}
+#endif
+
+// Histogram of circular runs of slots for which used(i) is true
+template <typename UsedSlot>
+static void fillClusterStats(PlayerTableStats& stats, int capacity, UsedSlot used) {
+    stats.clusterHistogram.assign(CLUSTER_HISTOGRAM_BUCKETS, 0);
+    stats.maxClusterSize = 0;
+
+    int firstEmpty = -1;
+    for (int i = 0; i < capacity && firstEmpty == -1; i++) {
+        if (!used(i)) firstEmpty = i;
+    }
+    if (firstEmpty == -1) {
+        stats.maxClusterSize = capacity;
+        if (capacity > 0) stats.clusterHistogram[CLUSTER_HISTOGRAM_BUCKETS - 1]++;
+        return;
+    }
+
+    // Start just after an empty slot so no run is split by the wrap-around
+    int run = 0;
+    for (int n = 1; n <= capacity; n++) {
+        int i = (firstEmpty + n) % capacity;
+        if (used(i)) {
+            run++;
+            continue;
+        }
+        if (run > 0) {
+            stats.clusterHistogram[min(run, CLUSTER_HISTOGRAM_BUCKETS) - 1]++;
+            stats.maxClusterSize = max(stats.maxClusterSize, run);
+        }
+        run = 0;
+    }
+}
+
+// Add one table's stats into a running total (used by multi-table engines)
+static void mergeStats(PlayerTableStats& total, const PlayerTableStats& part) {
+    long long insertOps = total.insertOps + part.insertOps;
+    long long searchOps = total.searchOps + part.searchOps;
+    if (insertOps) {
+        total.avgInsertProbes = (total.avgInsertProbes * total.insertOps +
+                                 part.avgInsertProbes * part.insertOps) / insertOps;
+    }
+    if (searchOps) {
+        total.avgSearchProbes = (total.avgSearchProbes * total.searchOps +
+                                 part.avgSearchProbes * part.searchOps) / searchOps;
+    }
+    total.tombstoneRatio = (total.tombstoneRatio * total.capacity +
+                            part.tombstoneRatio * part.capacity) / max(1, total.capacity + part.capacity);
+    total.insertOps = insertOps;
+    total.searchOps = searchOps;
+    total.maxInsertProbes = max(total.maxInsertProbes, part.maxInsertProbes);
+    total.maxSearchProbes = max(total.maxSearchProbes, part.maxSearchProbes);
+    total.size += part.size;
+    total.capacity += part.capacity;
+    total.loadFactor = total.capacity ? (double)total.size / total.capacity : 0.0;
+    total.maxClusterSize = max(total.maxClusterSize, part.maxClusterSize);
+    total.nameArenaBytes += part.nameArenaBytes;
+    total.rebuilds += part.rebuilds;
+
+    total.probeHistogram.resize(max(total.probeHistogram.size(), part.probeHistogram.size()), 0);
+    for (size_t i = 0; i < part.probeHistogram.size(); i++) {
+        total.probeHistogram[i] += part.probeHistogram[i];
+    }
+    total.clusterHistogram.resize(max(total.clusterHistogram.size(), part.clusterHistogram.size()), 0);
+    for (size_t i = 0; i < part.clusterHistogram.size(); i++) {
+        total.clusterHistogram[i] += part.clusterHistogram[i];
+    }
+}
+
+// Smallest prime >= n, used to pick capacities for the resizable table so
+// that hash2's step is always coprime with the table size
+static int nextPrime(int n) {
+    if (n <= 2) return 2;
+    if (n % 2 == 0) n++;
+    while (true) {
+        bool prime = true;
+        for (int d = 3; (long long)d * d <= n; d += 2) {
+            if (n % d == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) return n;
+        n += 2;
+    }
+}
+
 class ConcretePlayerTable : public PlayerTable {
 private:
-    // TODO: Define your data structures here
-    // Hint: You'll need a hash table with double hashing collision resolution
+    // Serves snapshots laid out with this class's probe sequence
+    friend class MappedPlayerTable;
+
     struct HashEntry {
         int playerID;
-        string name;
         bool occupied;
+        bool deleted;      // Tombstone: keeps probe chains through this slot intact
+        string_view name;  // Interned in names
 
-        HashEntry() : playerID(-1), name(""), occupied(false) {}
-        HashEntry(int id, const string& n) : playerID(id), name(n), occupied(true) {}
+        HashEntry() : playerID(-1), occupied(false), deleted(false), name() {}
+        HashEntry(int id, string_view n) : playerID(id), occupied(true), deleted(false), name(n) {}
     };
     static const int TABLE_SIZE = 101;  // Fixed size as per requirements
-    // Remove the vector and replace with:
-    HashEntry table[TABLE_SIZE];  // Fixed array instead of vector
-    // Add these constants at the top of class:
-    int currentSize = 0;
+    // Resizable mode: grow once live entries exceed this fraction of capacity
+    static constexpr double MAX_LOAD_FACTOR = 0.7;
+    // Resizable mode: old-table buckets migrated per insert/search call
+    static const int MIGRATE_PER_OP = 4;
+    // Lookups per probe-length sample used to decide on tombstone cleanup
+    static const int PROBE_WINDOW = 1024;
+
+    bool resizable;
+    int capacity;
+    vector<HashEntry> table;
+    int currentSize = 0;  // Live entries across table and oldTable
+    int tombstones = 0;   // Deleted slots in table (oldTable's are dropped by migration)
+    long long rebuilds = 0;
+    NameArena names;
+
+    // Optional reverse index. Keys are the same interned views the slots
+    // hold, so the index adds no copies of the names themselves.
+    bool indexNames;
+    unordered_multimap<string_view, int> nameIndex;
+
+    // Optional session expiry, created on the first insertWithTTL. The
+    // wheel keeps each player's live deadline, so refreshed or removed
+    // players' old timers never fire.
+    unique_ptr<TimerWheel> timers;
+
+    // Probe-length sampling over the last PROBE_WINDOW lookups in table
+    int windowLookups = 0;
+    long long windowProbes = 0;
+
+#if ARCADIA_TABLE_STATS
+    ProbeCounters insertProbes;
+    ProbeCounters searchProbes;
+#endif
+
+    // Incremental rehash state. While oldTable is non-empty, slots at index
+    // >= migrateCursor still hold live entries that have not been moved into
+    // table yet; slots below the cursor have already been migrated.
+    vector<HashEntry> oldTable;
+    int oldCapacity = 0;
+    int migrateCursor = 0;
+
     // Primary hash function
-    int hash1(int key) {
-        return key % TABLE_SIZE;
+    // Keys are taken as unsigned so negative IDs still map into [0, size)
+    static int hash1(int key, int size) {
+        return (int)((unsigned int)key % (unsigned int)size);
     }
     // Secondary hash function for double hashing
-    // Must return value in [1, TABLE_SIZE-1] and never 0
-    int hash2(int key) {
-        return 1 + (key % (TABLE_SIZE - 1));
+    // Must return value in [1, size-1] and never 0
+    static int hash2(int key, int size) {
+        return 1 + (int)((unsigned int)key % (unsigned int)(size - 1));
+    }
+
+    // Combined double hash for probing
+    static int doubleHash(int key, int attempt, int size) {
+        return (int)((hash1(key, size) + (long long)attempt * hash2(key, size)) % size);
+    }
+    // First free (empty or tombstone) slot for a key known to be absent
+    int findIndex(vector<HashEntry>& slots, int size, int playerID, int* probes = nullptr) {
+        for (int i = 0; i < size; i++) {
+            int index = doubleHash(playerID, i, size);
+            if (probes) *probes = i + 1;
+            //insert
+            if (!slots[index].occupied) {
+                return index;
+            }
+        }
+        return -1;
+    }
+    int findExistingIndex(const vector<HashEntry>& slots, int size, int playerID,
+                          int* probes = nullptr) const {
+        for (int attempt = 0; attempt < size; attempt++) {
+            int index = doubleHash(playerID, attempt, size);
+            if (probes) *probes = attempt + 1;
+
+            // Empty slot means not found; tombstones are probed past
+            if (!slots[index].occupied && !slots[index].deleted) {
+                return -1;
+            }
+
+            // Found and valid
+            if (slots[index].occupied &&
+                slots[index].playerID == playerID) {
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    bool migrating() const {
+        return !oldTable.empty();
+    }
+
+    // Move up to `buckets` old-table slots into the current table
+    void migrateStep(int buckets) {
+        while (migrating() && buckets > 0) {
+            HashEntry& entry = oldTable[migrateCursor];
+            if (entry.occupied) {
+                int index = findIndex(table, capacity, entry.playerID);
+                if (table[index].deleted) {
+                    tombstones--;
+                }
+                table[index] = entry;
+            }
+            migrateCursor++;
+            buckets--;
+            if (migrateCursor == oldCapacity) {
+                vector<HashEntry>().swap(oldTable);
+                oldCapacity = 0;
+                migrateCursor = 0;
+            }
+        }
+    }
+
+    // Swap in an empty table of newCapacity; existing entries are moved over
+    // a few buckets at a time by migrateStep
+    void startResize(int newCapacity) {
+        if (migrating()) {
+            migrateStep(oldCapacity - migrateCursor);
+        }
+        oldTable.swap(table);
+        oldCapacity = capacity;
+        migrateCursor = 0;
+        capacity = newCapacity;
+        table.assign(capacity, HashEntry());
+        tombstones = 0;
+    }
+
+    // Rebuild table at its current capacity without tombstones. Names stay
+    // in the arena, so views handed out earlier remain valid.
+    void cleanupTombstones() {
+        if (migrating()) {
+            migrateStep(oldCapacity - migrateCursor);
+        }
+        vector<HashEntry> rebuilt(capacity);
+        for (HashEntry& entry : table) {
+            if (entry.occupied) {
+                rebuilt[findIndex(rebuilt, capacity, entry.playerID)] = entry;
+            }
+        }
+        table.swap(rebuilt);
+        tombstones = 0;
+        windowLookups = 0;
+        windowProbes = 0;
+        rebuilds++;
+    }
+
+    // An O(capacity) rebuild only pays off once tombstones are a real
+    // fraction of the table; below that, growing or waiting is cheaper
+    bool worthRebuilding() const {
+        return (long long)tombstones * 8 >= capacity;
+    }
+
+    // Feed one lookup's probe count into the sampling window and clean up
+    // when tombstones have pushed the average well past what the live load
+    // alone predicts (1 / (1 - load) probes for double hashing)
+    void recordProbes(int probes) {
+        windowProbes += probes;
+        if (++windowLookups < PROBE_WINDOW) return;
+
+        double average = (double)windowProbes / windowLookups;
+        double liveLoad = (double)currentSize / capacity;
+        double expected = 1.0 / max(1.0 - liveLoad, 0.01);
+        windowLookups = 0;
+        windowProbes = 0;
+        if (worthRebuilding() && average > 2.0 * expected) {
+            cleanupTombstones();
+        }
+    }
+
+    // Re-intern every live name into a fresh arena, dropping replaced bytes
+    void compactNames() {
+        NameArena fresh;
+        nameIndex.clear();
+        for (HashEntry& entry : table) {
+            if (entry.occupied) {
+                entry.name = fresh.intern(entry.name);
+                indexName(entry);
+            }
+        }
+        for (int i = migrateCursor; i < oldCapacity; i++) {
+            if (oldTable[i].occupied) {
+                oldTable[i].name = fresh.intern(oldTable[i].name);
+                indexName(oldTable[i]);
+            }
+        }
+        names.swap(fresh);
+    }
+
+    void indexName(const HashEntry& entry) {
+        if (indexNames) {
+            nameIndex.emplace(entry.name, entry.playerID);
+        }
+    }
+
+    void unindexName(const HashEntry& entry) {
+        if (!indexNames) return;
+        auto range = nameIndex.equal_range(entry.name);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == entry.playerID) {
+                nameIndex.erase(it);
+                return;
+            }
+        }
+    }
+
+    void replaceName(HashEntry& entry, const string& name) {
+        unindexName(entry);
+        names.release(entry.name);
+        entry.name = names.intern(name);
+        indexName(entry);
+        if (names.needsCompaction()) {
+            compactNames();
+        }
+    }
+
+    // Index of an unmigrated entry in oldTable, or -1
+    int findInOldTable(int playerID) const {
+        if (!migrating()) return -1;
+        int index = findExistingIndex(oldTable, oldCapacity, playerID);
+        if (index < migrateCursor) return -1;
+        return index;
+    }
+
+
+public:
+    // resizable = false keeps the original fixed 101-slot behavior;
+    // indexNames maintains the name -> ID index behind searchByName
+    ConcretePlayerTable(bool resizable = false, int initialCapacity = TABLE_SIZE, bool indexNames = false)
+        : resizable(resizable), indexNames(indexNames) {
+        capacity = resizable ? nextPrime(max(initialCapacity, 3)) : TABLE_SIZE;
+        table.assign(capacity, HashEntry());
+        currentSize = 0;
+    }
+    void insert(int playerID, const string& name) override {
+        migrateStep(MIGRATE_PER_OP);
+
+        // Update in place if the player is already stored
+        int probes = 0;
+        int index = findExistingIndex(table, capacity, playerID, &probes);
+        if (index != -1) {
+#if ARCADIA_TABLE_STATS
+            insertProbes.record(probes);
+#endif
+            replaceName(table[index], name);
+            return;
+        }
+        index = findInOldTable(playerID);
+        if (index != -1) {
+            replaceName(oldTable[index], name);
+            return;
+        }
+
+        // Check if table is full
+        if (!resizable && currentSize >= capacity) {
+            throw "Table is full";
+        }
+        if (resizable && currentSize + tombstones + 1 > capacity * MAX_LOAD_FACTOR) {
+            // Reclaim tombstones in place only when there are enough of them;
+            // a handful left by churn at the limit would otherwise force a
+            // full rebuild every few inserts, so grow instead
+            if (currentSize + 1 <= capacity * MAX_LOAD_FACTOR && worthRebuilding()) {
+                cleanupTombstones();
+            }
+            else {
+                startResize(nextPrime(capacity * 2));
+                migrateStep(MIGRATE_PER_OP);
+            }
+        }
+
+        int placeProbes = 0;
+        index = findIndex(table, capacity, playerID, &placeProbes);
+        if (index == -1) {
+            throw "Table is full";
+        }
+#if ARCADIA_TABLE_STATS
+        insertProbes.record(probes + placeProbes);
+#endif
+
+        if (table[index].deleted) {
+            tombstones--;
+        }
+        currentSize++;
+        table[index] = HashEntry(playerID, names.intern(name));
+        indexName(table[index]);
+    }
+
+    void remove(int playerID) override {
+        migrateStep(MIGRATE_PER_OP);
+        if (timers) {
+            timers->cancel(playerID);
+        }
+
+        int index = findExistingIndex(table, capacity, playerID);
+        if (index != -1) {
+            unindexName(table[index]);
+            names.release(table[index].name);
+            table[index] = HashEntry();
+            table[index].deleted = true;
+            tombstones++;
+            currentSize--;
+            // Tombstones past a quarter of the table make every miss long
+            if (tombstones * 4 > capacity) {
+                cleanupTombstones();
+            }
+        }
+        else {
+            index = findInOldTable(playerID);
+            if (index == -1) return;
+            unindexName(oldTable[index]);
+            names.release(oldTable[index].name);
+            oldTable[index] = HashEntry();
+            oldTable[index].deleted = true;
+            currentSize--;
+        }
+        if (names.needsCompaction()) {
+            compactNames();
+        }
+    }
+
+    double tombstoneRatio() override {
+        return (double)tombstones / capacity;
+    }
+
+    void insertWithTTL(int playerID, const string& name, long long ttl) override {
+        insert(playerID, name);
+        if (!timers) {
+            timers.reset(new TimerWheel());
+        }
+        timers->schedule(playerID, timers->currentTime() + max(ttl, 1LL));
+    }
+
+    void advanceTime(long long ticks) override {
+        if (!timers) return;
+        vector<TimerWheel::Timer> expired;
+        timers->advance(ticks, expired);
+        for (const TimerWheel::Timer& timer : expired) {
+            remove(timer.playerID);
+        }
+    }
+
+    void saveSnapshot(const string& path) override {
+        if (migrating()) {
+            migrateStep(oldCapacity - migrateCursor);
+        }
+
+        // Re-probe every live entry into a tombstone-free layout, since a
+        // mapped reader stops at the first empty slot just like findExistingIndex
+        vector<PlayerSnapshotSlot> slots(capacity, PlayerSnapshotSlot{ 0, 0, 0, 0 });
+        string blob;
+        for (const HashEntry& entry : table) {
+            if (!entry.occupied) continue;
+            if (blob.size() + entry.name.size() > UINT32_MAX) {
+                throw "Snapshot names exceed 4 GiB";
+            }
+            for (int attempt = 0; attempt < capacity; attempt++) {
+                PlayerSnapshotSlot& slot = slots[doubleHash(entry.playerID, attempt, capacity)];
+                if (!slot.occupied) {
+                    slot.playerID = entry.playerID;
+                    slot.occupied = 1;
+                    slot.nameOffset = (uint32_t)blob.size();
+                    slot.nameLength = (uint32_t)entry.name.size();
+                    break;
+                }
+            }
+            blob.append(entry.name.data(), entry.name.size());
+        }
+        writePlayerSnapshot(path, resizable, currentSize, slots, blob);
+    }
+
+    string search(int playerID) override {
+        return string(searchView(playerID));
+    }
+
+    string_view searchView(int playerID) override {
+        migrateStep(MIGRATE_PER_OP);
+
+        string_view result;
+        int probes = 0;
+        int index = findExistingIndex(table, capacity, playerID, &probes);
+        if (index != -1) {
+            result = table[index].name;
+        }
+        else {
+            index = findInOldTable(playerID);
+            if (index != -1) {
+                result = oldTable[index].name;
+            }
+        }
+#if ARCADIA_TABLE_STATS
+        searchProbes.record(probes);
+#endif
+        recordProbes(probes);
+        return result;
+    }
+
+    PlayerTableStats stats() override {
+        PlayerTableStats result;
+        result.size = currentSize;
+        result.capacity = capacity;
+        result.loadFactor = (double)currentSize / capacity;
+        result.tombstoneRatio = (double)tombstones / capacity;
+        result.rebuilds = rebuilds;
+#if ARCADIA_TABLE_STATS
+        fillProbeStats(result, insertProbes, searchProbes);
+#endif
+        fillClusterStats(result, capacity, [this](int i) {
+            return table[i].occupied || table[i].deleted;
+        });
+        result.nameArenaBytes = (long long)names.reservedBytes();
+        return result;
+    }
+
+    vector<int> searchByName(const string& name) override {
+        if (!indexNames) {
+            return PlayerTable::searchByName(name);
+        }
+        vector<int> result;
+        auto range = nameIndex.equal_range(string_view(name));
+        for (auto it = range.first; it != range.second; ++it) {
+            result.push_back(it->second);
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Read-only lookup: does not advance migration or probe sampling, so
+    // concurrent callers only need to exclude writers
+    string_view peek(int playerID) const {
+        int index = findExistingIndex(table, capacity, playerID);
+        if (index != -1) {
+            return table[index].name;
+        }
+        index = findInOldTable(playerID);
+        if (index != -1) {
+            return oldTable[index].name;
+        }
+        return string_view();
+    }
+
+    void insertBatch(const vector<pair<int, string>>& entries) override {
+        for (size_t start = 0; start < entries.size(); start += BATCH_WINDOW) {
+            size_t end = min(entries.size(), start + BATCH_WINDOW);
+            // Pull every home bucket of the window in before inserting
+            for (size_t i = start; i < end; i++) {
+                ARCADIA_PREFETCH(&table[hash1(entries[i].first, capacity)]);
+            }
+            for (size_t i = start; i < end; i++) {
+                insert(entries[i].first, entries[i].second);
+            }
+        }
+    }
+
+    void searchBatch(const vector<int>& playerIDs, vector<string_view>& results) override {
+        results.resize(playerIDs.size());
+        if (migrating()) {
+            // Keys may live in either table; take the per-key path until
+            // the migration finishes
+            PlayerTable::searchBatch(playerIDs, results);
+            return;
+        }
+
+        int slot[BATCH_WINDOW];
+        int step[BATCH_WINDOW];
+        int attempts[BATCH_WINDOW];
+        int pending[BATCH_WINDOW];
+        for (size_t start = 0; start < playerIDs.size(); start += BATCH_WINDOW) {
+            int count = (int)min(playerIDs.size() - start, (size_t)BATCH_WINDOW);
+            for (int k = 0; k < count; k++) {
+                int key = playerIDs[start + k];
+                slot[k] = hash1(key, capacity);
+                step[k] = hash2(key, capacity);
+                attempts[k] = 0;
+                pending[k] = k;
+                ARCADIA_PREFETCH(&table[slot[k]]);
+            }
+
+            // Each round advances every unresolved key by one probe, so the
+            // prefetch issued for a key's next slot lands while the others
+            // are being examined
+            int active = count;
+            while (active > 0) {
+                int stillActive = 0;
+                for (int p = 0; p < active; p++) {
+                    int k = pending[p];
+                    const HashEntry& entry = table[slot[k]];
+                    // attempts[k] ends as the key's probe count, as in search()
+                    attempts[k]++;
+                    if (entry.occupied && entry.playerID == playerIDs[start + k]) {
+                        results[start + k] = entry.name;
+                    }
+                    else if ((!entry.occupied && !entry.deleted) || attempts[k] >= capacity) {
+                        results[start + k] = string_view();
+                    }
+                    else {
+                        slot[k] = (int)((slot[k] + (long long)step[k]) % capacity);
+                        ARCADIA_PREFETCH(&table[slot[k]]);
+                        pending[stillActive++] = k;
+                    }
+                }
+                active = stillActive;
+            }
+
+            // Only once the window is resolved: recordProbes may rebuild the
+            // table, which would strand slot[] mid-probe
+            for (int k = 0; k < count; k++) {
+#if ARCADIA_TABLE_STATS
+                searchProbes.record(attempts[k]);
+#endif
+                recordProbes(attempts[k]);
+            }
+        }
+    }
+};
+
+// --- 1b. FlatPlayerTable (Control Bytes + Group Probing) ---
+
+// Control byte states. A full slot stores the low 7 bits of the key's hash
+// (0..127), so empty and deleted slots are the only ones with the sign bit set.
+static const signed char CTRL_EMPTY = -128;
+static const signed char CTRL_DELETED = -2;
+
+#if defined(__AVX2__)
+static const int CTRL_GROUP_WIDTH = 32;
+#else
+static const int CTRL_GROUP_WIDTH = 16;
+#endif
+
+// Bitmask of the bytes in the group starting at ctrl that equal b
+static inline unsigned int matchCtrlGroup(const signed char* ctrl, signed char b) {
+#if defined(__AVX2__)
+    __m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl));
+    return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(group, _mm256_set1_epi8(b)));
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(b)));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < CTRL_GROUP_WIDTH; i++) {
+        if (ctrl[i] == b) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Bitmask of the empty or deleted bytes in the group starting at ctrl
+static inline unsigned int matchCtrlFree(const signed char* ctrl) {
+#if defined(__AVX2__)
+    return (unsigned int)_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl)));
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < CTRL_GROUP_WIDTH; i++) {
+        if (ctrl[i] < 0) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Index of the lowest set bit of a non-zero mask
+static inline int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+class FlatPlayerTable : public PlayerTable {
+private:
+    // ctrl, keys and names are parallel arrays; a probe only reads ctrl
+    // until a fingerprint matches, so a miss touches one cache line per group
+    vector<signed char> ctrl;
+    vector<int> keys;
+    vector<string_view> names;  // Interned in nameArena
+    NameArena nameArena;
+    int capacity;     // Power of two, multiple of CTRL_GROUP_WIDTH
+    int currentSize;
+    int tombstones;
+    long long rebuilds = 0;
+
+#if ARCADIA_TABLE_STATS
+    ProbeCounters insertProbes;  // Counted in groups scanned
+    ProbeCounters searchProbes;
+#endif
+
+    // 64-bit finalizer so both the group index and the fingerprint are
+    // well mixed even for sequential or strided IDs
+    static unsigned long long mixHash(int key) {
+        unsigned long long h = (unsigned int)key;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+    static signed char fingerprint(unsigned long long h) {
+        return (signed char)(h & 0x7F);
+    }
+    int groupCount() const {
+        return capacity / CTRL_GROUP_WIDTH;
+    }
+    // Groups are visited in triangular order, which covers every group
+    // when the group count is a power of two
+    int startGroup(unsigned long long h) const {
+        return (int)((h >> 7) & (unsigned long long)(groupCount() - 1));
+    }
+
+    int findExistingIndex(int playerID, int* probes = nullptr) {
+        return findExistingIndex(playerID, mixHash(playerID), probes);
+    }
+    // probes, if given, receives the number of groups scanned
+    int findExistingIndex(int playerID, unsigned long long h, int* probes = nullptr) {
+        signed char fp = fingerprint(h);
+        int group = startGroup(h);
+        for (int step = 1; step <= groupCount(); step++) {
+            if (probes) *probes = step;
+            const signed char* base = &ctrl[group * CTRL_GROUP_WIDTH];
+            unsigned int mask = matchCtrlGroup(base, fp);
+            while (mask) {
+                int index = group * CTRL_GROUP_WIDTH + lowestBit(mask);
+                if (keys[index] == playerID) {
+                    return index;
+                }
+                mask &= mask - 1;
+            }
+            // An empty slot ends the probe chain
+            if (matchCtrlGroup(base, CTRL_EMPTY)) {
+                return -1;
+            }
+            group = (group + step) & (groupCount() - 1);
+        }
+        return -1;
+    }
+
+    // First empty or deleted slot along playerID's probe sequence
+    int findFreeIndex(int playerID, int* probes = nullptr) {
+        unsigned long long h = mixHash(playerID);
+        int group = startGroup(h);
+        for (int step = 1; step <= groupCount(); step++) {
+            if (probes) *probes = step;
+            unsigned int mask = matchCtrlFree(&ctrl[group * CTRL_GROUP_WIDTH]);
+            if (mask) {
+                return group * CTRL_GROUP_WIDTH + lowestBit(mask);
+            }
+            group = (group + step) & (groupCount() - 1);
+        }
+        return -1;
+    }
+
+    void rehash(int newCapacity) {
+        vector<signed char> oldCtrl;
+        vector<int> oldKeys;
+        vector<string_view> oldNames;
+        oldCtrl.swap(ctrl);
+        oldKeys.swap(keys);
+        oldNames.swap(names);
+
+        capacity = newCapacity;
+        ctrl.assign(capacity, CTRL_EMPTY);
+        keys.assign(capacity, 0);
+        names.assign(capacity, string_view());
+        tombstones = 0;
+        if (newCapacity == (int)oldCtrl.size()) {
+            rebuilds++;
+        }
+
+        for (size_t i = 0; i < oldCtrl.size(); i++) {
+            if (oldCtrl[i] >= 0) {
+                int index = findFreeIndex(oldKeys[i]);
+                ctrl[index] = oldCtrl[i];
+                keys[index] = oldKeys[i];
+                names[index] = oldNames[i];
+            }
+        }
+    }
+
+    void compactNames() {
+        NameArena fresh;
+        for (int i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) names[i] = fresh.intern(names[i]);
+        }
+        nameArena.swap(fresh);
+    }
+
+public:
+    FlatPlayerTable(int initialCapacity = 64) {
+        capacity = CTRL_GROUP_WIDTH;
+        while (capacity < initialCapacity) capacity *= 2;
+        ctrl.assign(capacity, CTRL_EMPTY);
+        keys.assign(capacity, 0);
+        names.assign(capacity, string_view());
+        currentSize = 0;
+        tombstones = 0;
+    }
+
+    void insert(int playerID, const string& name) override {
+        int probes = 0;
+        int index = findExistingIndex(playerID, &probes);
+        if (index != -1) {
+#if ARCADIA_TABLE_STATS
+            insertProbes.record(probes);
+#endif
+            nameArena.release(names[index]);
+            names[index] = nameArena.intern(name);
+            if (nameArena.needsCompaction()) {
+                compactNames();
+            }
+            return;
+        }
+
+        // Keep at least 1/8 of the slots empty so misses terminate quickly;
+        // if tombstones are what fills the table, rebuild in place instead
+        if ((long long)(currentSize + tombstones + 1) * 8 > (long long)capacity * 7) {
+            bool liveNeedsRoom = (long long)(currentSize + 1) * 16 > (long long)capacity * 7;
+            rehash(liveNeedsRoom ? capacity * 2 : capacity);
+        }
+
+        int placeProbes = 0;
+        index = findFreeIndex(playerID, &placeProbes);
+#if ARCADIA_TABLE_STATS
+        insertProbes.record(probes + placeProbes);
+#endif
+        if (ctrl[index] == CTRL_DELETED) {
+            tombstones--;
+        }
+        ctrl[index] = fingerprint(mixHash(playerID));
+        keys[index] = playerID;
+        names[index] = nameArena.intern(name);
+        currentSize++;
+    }
+
+    void remove(int playerID) override {
+        int index = findExistingIndex(playerID);
+        if (index == -1) return;
+
+        nameArena.release(names[index]);
+        names[index] = string_view();
+        currentSize--;
+        // A group that still has an empty slot has never been probed past,
+        // so the slot can go straight back to empty without a tombstone
+        int base = index - index % CTRL_GROUP_WIDTH;
+        if (matchCtrlGroup(&ctrl[base], CTRL_EMPTY)) {
+            ctrl[index] = CTRL_EMPTY;
+        }
+        else {
+            ctrl[index] = CTRL_DELETED;
+            tombstones++;
+        }
+        if (nameArena.needsCompaction()) {
+            compactNames();
+        }
+    }
+
+    double tombstoneRatio() override {
+        return (double)tombstones / capacity;
+    }
+
+    string search(int playerID) override {
+        return string(searchView(playerID));
+    }
+
+    string_view searchView(int playerID) override {
+        int probes = 0;
+        int index = findExistingIndex(playerID, &probes);
+#if ARCADIA_TABLE_STATS
+        searchProbes.record(probes);
+#endif
+        if (index != -1) {
+            return names[index];
+        }
+        return string_view();
+    }
+
+    PlayerTableStats stats() override {
+        PlayerTableStats result;
+        result.size = currentSize;
+        result.capacity = capacity;
+        result.loadFactor = (double)currentSize / capacity;
+        result.tombstoneRatio = (double)tombstones / capacity;
+        result.rebuilds = rebuilds;
+#if ARCADIA_TABLE_STATS
+        fillProbeStats(result, insertProbes, searchProbes);
+#endif
+        fillClusterStats(result, capacity, [this](int i) {
+            return ctrl[i] != CTRL_EMPTY;
+        });
+        result.nameArenaBytes = (long long)nameArena.reservedBytes();
+        return result;
+    }
+
+    void insertBatch(const vector<pair<int, string>>& entries) override {
+        for (size_t start = 0; start < entries.size(); start += BATCH_WINDOW) {
+            size_t end = min(entries.size(), start + BATCH_WINDOW);
+            for (size_t i = start; i < end; i++) {
+                int group = startGroup(mixHash(entries[i].first));
+                ARCADIA_PREFETCH(&ctrl[group * CTRL_GROUP_WIDTH]);
+            }
+            for (size_t i = start; i < end; i++) {
+                insert(entries[i].first, entries[i].second);
+            }
+        }
+    }
+
+    void searchBatch(const vector<int>& playerIDs, vector<string_view>& results) override {
+        results.resize(playerIDs.size());
+        unsigned long long hashes[BATCH_WINDOW];
+        for (size_t start = 0; start < playerIDs.size(); start += BATCH_WINDOW) {
+            int count = (int)min(playerIDs.size() - start, (size_t)BATCH_WINDOW);
+            // Hash the window and bring in each home group's control bytes
+            // and key slots before any of them is scanned
+            for (int k = 0; k < count; k++) {
+                hashes[k] = mixHash(playerIDs[start + k]);
+                int base = startGroup(hashes[k]) * CTRL_GROUP_WIDTH;
+                ARCADIA_PREFETCH(&ctrl[base]);
+                ARCADIA_PREFETCH(&keys[base]);
+            }
+            for (int k = 0; k < count; k++) {
+                int probes = 0;
+                int index = findExistingIndex(playerIDs[start + k], hashes[k], &probes);
+#if ARCADIA_TABLE_STATS
+                searchProbes.record(probes);
+#endif
+                results[start + k] = index != -1 ? names[index] : string_view();
+            }
+        }
+    }
+};
+
+// --- 1c. ShardedPlayerTable (Concurrent) ---
+
+// Thread-safe PlayerTable made of independently locked ConcretePlayerTable
+// shards. Lookups take their shard's lock in shared mode and use the
+// side-effect-free peek(), so readers never block each other; writers only
+// contend with operations on the same shard. Views returned by searchView
+// point into a shard's name arena and may be invalidated by a concurrent
+// insert into that shard; use search() when a stable copy is needed.
+class ShardedPlayerTable : public PlayerTable {
+private:
+    struct alignas(64) Shard {
+        mutable shared_mutex lock;
+        ConcretePlayerTable table;
+
+        Shard() : table(true) {}
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    unsigned int shardMask;  // shards.size() - 1, a power of two minus one
+
+    // Fibonacci hashing spreads strided IDs across shards; the top bits
+    // are used because they depend on every bit of the key
+    Shard& shardFor(int playerID) const {
+        unsigned int h = (unsigned int)playerID * 2654435769u;
+        return *shards[(h >> 16) & shardMask];
+    }
+
+public:
+    ShardedPlayerTable(int shardCount = 64) {
+        int count = 1;
+        while (count < shardCount) count *= 2;
+        for (int i = 0; i < count; i++) {
+            shards.emplace_back(new Shard());
+        }
+        shardMask = (unsigned int)(count - 1);
+    }
+
+    void insert(int playerID, const string& name) override {
+        Shard& shard = shardFor(playerID);
+        unique_lock<shared_mutex> guard(shard.lock);
+        shard.table.insert(playerID, name);
+    }
+
+    void remove(int playerID) override {
+        Shard& shard = shardFor(playerID);
+        unique_lock<shared_mutex> guard(shard.lock);
+        shard.table.remove(playerID);
+    }
+
+    string search(int playerID) override {
+        Shard& shard = shardFor(playerID);
+        shared_lock<shared_mutex> guard(shard.lock);
+        return string(shard.table.peek(playerID));
+    }
+
+    string_view searchView(int playerID) override {
+        Shard& shard = shardFor(playerID);
+        shared_lock<shared_mutex> guard(shard.lock);
+        return shard.table.peek(playerID);
+    }
+
+    double tombstoneRatio() override {
+        double total = 0.0;
+        for (auto& shard : shards) {
+            shared_lock<shared_mutex> guard(shard->lock);
+            total += shard->table.tombstoneRatio();
+        }
+        return total / shards.size();
+    }
+
+    // Each shard runs its own timer wheel; advancing time visits them all
+    void insertWithTTL(int playerID, const string& name, long long ttl) override {
+        Shard& shard = shardFor(playerID);
+        unique_lock<shared_mutex> guard(shard.lock);
+        shard.table.insertWithTTL(playerID, name, ttl);
+    }
+
+    void advanceTime(long long ticks) override {
+        for (auto& shard : shards) {
+            unique_lock<shared_mutex> guard(shard->lock);
+            shard->table.advanceTime(ticks);
+        }
+    }
+
+    // Sum over shards. Readers go through peek(), which keeps no counters,
+    // so search probe figures here only reflect writer-side lookups.
+    PlayerTableStats stats() override {
+        PlayerTableStats total;
+        for (auto& shard : shards) {
+            unique_lock<shared_mutex> guard(shard->lock);
+            mergeStats(total, shard->table.stats());
+        }
+        return total;
+    }
+};
+
+// --- 1d. MappedPlayerTable (Snapshot Warm Start) ---
+
+// Serves search() straight from a memory-mapped snapshot written by
+// ConcretePlayerTable::saveSnapshot, so a restart needs no re-insertion.
+// The first mutation copies the snapshot into a regular ConcretePlayerTable
+// and releases the mapping; from then on every call is forwarded to it.
+class MappedPlayerTable : public PlayerTable {
+private:
+    unique_ptr<MappedFile> file;
+    const PlayerSnapshotHeader* header = nullptr;
+    const PlayerSnapshotSlot* slots = nullptr;
+    const char* blob = nullptr;
+    unique_ptr<ConcretePlayerTable> promoted;
+
+    int findSlot(int playerID) const {
+        int capacity = (int)header->capacity;
+        for (int attempt = 0; attempt < capacity; attempt++) {
+            int index = ConcretePlayerTable::doubleHash(playerID, attempt, capacity);
+            if (!slots[index].occupied) {
+                return -1;
+            }
+            if (slots[index].playerID == playerID) {
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    // Copy-on-write: materialize the snapshot before the first mutation
+    ConcretePlayerTable& mutableTable() {
+        if (!promoted) {
+            promoted.reset(new ConcretePlayerTable(header->resizable != 0, (int)header->capacity));
+            for (uint32_t i = 0; i < header->capacity; i++) {
+                if (slots[i].occupied) {
+                    promoted->insert(slots[i].playerID,
+                        string(blob + slots[i].nameOffset, slots[i].nameLength));
+                }
+            }
+            header = nullptr;
+            slots = nullptr;
+            blob = nullptr;
+            file.reset();
+        }
+        return *promoted;
+    }
+
+public:
+    MappedPlayerTable(const string& path) : file(new MappedFile(path)) {
+        const char* bytes = file->bytes();
+        size_t size = file->size();
+        if (size < sizeof(PlayerSnapshotHeader)) {
+            throw "Invalid snapshot";
+        }
+        header = reinterpret_cast<const PlayerSnapshotHeader*>(bytes);
+        uint64_t slotBytes = (uint64_t)header->capacity * sizeof(PlayerSnapshotSlot);
+        uint64_t bodyBytes = size - sizeof(PlayerSnapshotHeader);
+        // Subtract rather than add so a huge blobSize cannot wrap
+        if (memcmp(header->magic, PLAYER_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != 1 || header->capacity < 2 ||
+            slotBytes > bodyBytes || header->blobSize != bodyBytes - slotBytes) {
+            throw "Invalid snapshot";
+        }
+        slots = reinterpret_cast<const PlayerSnapshotSlot*>(bytes + sizeof(PlayerSnapshotHeader));
+        blob = bytes + sizeof(PlayerSnapshotHeader) + slotBytes;
+        // searchView builds views straight from these, so every name must
+        // lie inside the blob
+        for (uint32_t i = 0; i < header->capacity; i++) {
+            if (slots[i].occupied &&
+                (uint64_t)slots[i].nameOffset + slots[i].nameLength > header->blobSize) {
+                throw "Invalid snapshot";
+            }
+        }
+    }
+
+    void insert(int playerID, const string& name) override {
+        mutableTable().insert(playerID, name);
+    }
+
+    void remove(int playerID) override {
+        mutableTable().remove(playerID);
+    }
+
+    void insertWithTTL(int playerID, const string& name, long long ttl) override {
+        mutableTable().insertWithTTL(playerID, name, ttl);
+    }
+
+    // Snapshots carry no expiries, so only a promoted table has timers
+    void advanceTime(long long ticks) override {
+        if (promoted) {
+            promoted->advanceTime(ticks);
+        }
+    }
+
+    string search(int playerID) override {
+        return string(searchView(playerID));
+    }
+
+    string_view searchView(int playerID) override {
+        if (promoted) {
+            return promoted->searchView(playerID);
+        }
+        int index = findSlot(playerID);
+        if (index == -1) {
+            return string_view();
+        }
+        return string_view(blob + slots[index].nameOffset, slots[index].nameLength);
+    }
+
+    double tombstoneRatio() override {
+        return promoted ? promoted->tombstoneRatio() : 0.0;
+    }
+
+    PlayerTableStats stats() override {
+        if (promoted) {
+            return promoted->stats();
+        }
+        PlayerTableStats result;
+        result.size = (int)header->count;
+        result.capacity = (int)header->capacity;
+        result.loadFactor = (double)result.size / result.capacity;
+        fillClusterStats(result, result.capacity, [this](int i) {
+            return slots[i].occupied != 0;
+        });
+        return result;
+    }
+
+    void saveSnapshot(const string& path) override {
+        // Promote first so overwriting the mapped file itself is safe
+        mutableTable().saveSnapshot(path);
+    }
+};
+
+// --- 1e. StaticPlayerTable (Compile-Time Capacity + Hash Policy) ---
+
+// A hash policy gives the home slot, the probe step and how to advance by
+// that step for a compile-time Capacity. Keys are hashed as unsigned, so
+// negative IDs land in range like any other.
+
+constexpr bool isPrimeCapacity(int n) {
+    if (n < 2) return false;
+    for (int d = 2; (long long)d * d <= n; d++) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+constexpr int log2Capacity(int n) {
+    return n <= 1 ? 0 : 1 + log2Capacity(n / 2);
+}
+
+// Classic double hashing over a prime capacity. The divisor is a constant,
+// so the compiler turns every % into a multiply and shift.
+template <int Capacity>
+struct PrimeModuloHash {
+    static_assert(isPrimeCapacity(Capacity), "PrimeModuloHash needs a prime capacity");
+
+    static unsigned int home(int key) {
+        return (unsigned int)key % Capacity;
+    }
+    static unsigned int step(int key) {
+        return 1 + (unsigned int)key % (Capacity - 1);
+    }
+    static unsigned int next(unsigned int index, unsigned int step) {
+        index += step;
+        return index >= (unsigned int)Capacity ? index - Capacity : index;
+    }
+};
+
+// Fibonacci (multiplicative) hashing over a power-of-two capacity: the home
+// slot is the top bits of key * 2^32/phi, and the step is forced odd so it
+// is coprime with the capacity and the probe visits every slot.
+template <int Capacity>
+struct FibonacciHash {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "FibonacciHash needs a power-of-two capacity");
+    static const int SHIFT = 32 - log2Capacity(Capacity);
+
+    static unsigned int home(int key) {
+        return ((unsigned int)key * 2654435769u) >> SHIFT;
+    }
+    static unsigned int step(int key) {
+        return (((unsigned int)key * 0x85EBCA6Bu) >> SHIFT) | 1u;
+    }
+    static unsigned int next(unsigned int index, unsigned int step) {
+        return (index + step) & (unsigned int)(Capacity - 1);
+    }
+};
+
+// Fixed-capacity double hashing table whose capacity and hash functions are
+// known at compile time. The probe loop advances by adding the step instead
+// of recomputing (hash1 + attempt * hash2) % size on every attempt.
+template <int Capacity, template <int> class HashPolicy = PrimeModuloHash>
+class StaticPlayerTable : public PlayerTable {
+private:
+    typedef HashPolicy<Capacity> Policy;
+
+    struct HashEntry {
+        int playerID;
+        bool occupied;
+        bool deleted;
+        string_view name;  // Interned in names
+
+        HashEntry() : playerID(-1), occupied(false), deleted(false), name() {}
+        HashEntry(int id, string_view n) : playerID(id), occupied(true), deleted(false), name(n) {}
+    };
+
+    vector<HashEntry> table;
+    int currentSize = 0;
+    int tombstones = 0;
+    long long rebuilds = 0;
+    NameArena names;
+
+#if ARCADIA_TABLE_STATS
+    ProbeCounters insertProbes;
+    ProbeCounters searchProbes;
+#endif
+
+    // Slot holding playerID, or -1; *freeSlot receives the first empty or
+    // tombstone slot seen on the way (-1 if none)
+    int probe(int playerID, int* freeSlot, int* probes) const {
+        unsigned int index = Policy::home(playerID);
+        unsigned int step = Policy::step(playerID);
+        *freeSlot = -1;
+        for (int attempt = 0; attempt < Capacity; attempt++) {
+            *probes = attempt + 1;
+            const HashEntry& entry = table[index];
+            if (entry.occupied) {
+                if (entry.playerID == playerID) return (int)index;
+            }
+            else {
+                if (*freeSlot == -1) *freeSlot = (int)index;
+                if (!entry.deleted) return -1;
+            }
+            index = Policy::next(index, step);
+        }
+        return -1;
+    }
+
+    void cleanupTombstones() {
+        vector<HashEntry> rebuilt(Capacity);
+        for (const HashEntry& entry : table) {
+            if (!entry.occupied) continue;
+            unsigned int index = Policy::home(entry.playerID);
+            unsigned int step = Policy::step(entry.playerID);
+            while (rebuilt[index].occupied) {
+                index = Policy::next(index, step);
+            }
+            rebuilt[index] = entry;
+        }
+        table.swap(rebuilt);
+        tombstones = 0;
+        rebuilds++;
+    }
+
+    // Re-intern every live name into a fresh arena, dropping released bytes
+    void compactNames() {
+        NameArena fresh;
+        for (HashEntry& entry : table) {
+            if (entry.occupied) entry.name = fresh.intern(entry.name);
+        }
+        names.swap(fresh);
+    }
+
+public:
+    StaticPlayerTable() : table(Capacity) {}
+
+    void insert(int playerID, const string& name) override {
+        int freeSlot, probes = 0;
+        int index = probe(playerID, &freeSlot, &probes);
+#if ARCADIA_TABLE_STATS
+        insertProbes.record(probes);
+#endif
+        if (index != -1) {
+            names.release(table[index].name);
+            table[index].name = names.intern(name);
+            if (names.needsCompaction()) {
+                compactNames();
+            }
+            return;
+        }
+        if (currentSize >= Capacity || freeSlot == -1) {
+            throw "Table is full";
+        }
+        if (table[freeSlot].deleted) {
+            tombstones--;
+        }
+        table[freeSlot] = HashEntry(playerID, names.intern(name));
+        currentSize++;
+    }
+
+    void remove(int playerID) override {
+        int freeSlot, probes = 0;
+        int index = probe(playerID, &freeSlot, &probes);
+        if (index == -1) return;
+
+        names.release(table[index].name);
+        table[index] = HashEntry();
+        table[index].deleted = true;
+        tombstones++;
+        currentSize--;
+        if (tombstones * 4 > Capacity) {
+            cleanupTombstones();
+        }
+        if (names.needsCompaction()) {
+            compactNames();
+        }
+    }
+
+    string search(int playerID) override {
+        return string(searchView(playerID));
+    }
+
+    string_view searchView(int playerID) override {
+        int freeSlot, probes = 0;
+        int index = probe(playerID, &freeSlot, &probes);
+#if ARCADIA_TABLE_STATS
+        searchProbes.record(probes);
+#endif
+        return index != -1 ? table[index].name : string_view();
+    }
+
+    double tombstoneRatio() override {
+        return (double)tombstones / Capacity;
+    }
+
+    PlayerTableStats stats() override {
+        PlayerTableStats result;
+        result.size = currentSize;
+        result.capacity = Capacity;
+        result.loadFactor = (double)currentSize / Capacity;
+        result.tombstoneRatio = (double)tombstones / Capacity;
+        result.rebuilds = rebuilds;
+#if ARCADIA_TABLE_STATS
+        fillProbeStats(result, insertProbes, searchProbes);
+#endif
+        fillClusterStats(result, Capacity, [this](int i) {
+            return table[i].occupied || table[i].deleted;
+        });
+        result.nameArenaBytes = (long long)names.reservedBytes();
+        return result;
+    }
+};
+
+// --- 2. Leaderboard (Skip List) ---
+
+// Default rank queries for boards without an indexed layout; they read the
+// whole ranking through getTopN
+int Leaderboard::getRank(int playerID) {
+    vector<int> ranking = getTopN(INT_MAX);
+    for (size_t i = 0; i < ranking.size(); i++) {
+        if (ranking[i] == playerID) return (int)i + 1;
+    }
+    return -1;
+}
+
+int Leaderboard::getByRank(int rank) {
+    if (rank < 1) return -1;
+    vector<int> ranking = getTopN(rank);
+    return (int)ranking.size() == rank ? ranking.back() : -1;
+}
+
+vector<int> Leaderboard::getPlayersAroundRank(int rank, int radius) {
+    int first = max(1, rank - radius);
+    int last = rank + radius;
+    vector<int> ranking = getTopN(last);
+    if (first > (int)ranking.size()) return vector<int>();
+    return vector<int>(ranking.begin() + (first - 1), ranking.end());
+}
+
+int Leaderboard::countInScoreRange(int minScore, int maxScore) {
+    throw "Score range queries not supported";
+}
+
+vector<int> Leaderboard::getPlayersInScoreRange(int minScore, int maxScore) {
+    throw "Score range queries not supported";
+}
+
+// Position (1-based, lowest score first) of the nearest-rank percentile
+static int percentilePosition(double pct, int total) {
+    double clamped = max(0.0, min(100.0, pct));
+    return max(1, (int)ceil(clamped * total / 100.0));
+}
+
+double Leaderboard::percentile(int score) {
+    int total = countInScoreRange(INT_MIN, INT_MAX);
+    if (total == 0) return 0.0;
+    int below = score == INT_MIN ? 0 : countInScoreRange(INT_MIN, score - 1);
+    return 100.0 * below / total;
+}
+
+// Binary search over scores: O(32) range counts
+int Leaderboard::scoreAtPercentile(double pct) {
+    int total = countInScoreRange(INT_MIN, INT_MAX);
+    if (total == 0) throw "Leaderboard is empty";
+    int position = percentilePosition(pct, total);
+    long long lo = INT_MIN, hi = INT_MAX;
+    while (lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+        if (countInScoreRange(INT_MIN, (int)mid) >= position) hi = mid;
+        else lo = mid + 1;
+    }
+    return (int)lo;
+}
+
+// bucketCount + 1 range counts, one per bucket boundary
+vector<int> Leaderboard::getScoreHistogram(int minScore, int bucketWidth, int bucketCount) {
+    if (bucketWidth < 1 || bucketCount < 0) throw "Invalid histogram buckets";
+    vector<int> counts(bucketCount);
+    int atLeastLower = countInScoreRange(minScore, INT_MAX);
+    for (int i = 0; i < bucketCount; i++) {
+        long long upper = (long long)minScore + (long long)(i + 1) * bucketWidth;
+        int atLeastUpper = upper > INT_MAX ? 0 : countInScoreRange((int)upper, INT_MAX);
+        counts[i] = atLeastLower - atLeastUpper;
+        atLeastLower = atLeastUpper;
+    }
+    return counts;
+}
+
+void Leaderboard::flush() {
+}
+
+void Leaderboard::rollover() {
+    throw "Time windows not supported";
+}
+
+void Leaderboard::bulkLoad(const vector<pair<int, int>>& entries) {
+    for (const auto& entry : entries) {
+        addScore(entry.first, entry.second);
+    }
+}
+
+void Leaderboard::saveSnapshot(const string& path) {
+    throw "Snapshot not supported";
+}
+
+void Leaderboard::watchTopK(int k, int capacity) {
+    throw "Rank events not supported";
+}
+
+int Leaderboard::pollRankEvents(RankEvent* out, int maxEvents) {
+    throw "Rank events not supported";
+}
+
+int Leaderboard::getTopN(int n, int* out) {
+    vector<int> top = getTopN(n);
+    copy(top.begin(), top.end(), out);
+    return (int)top.size();
+}
+
+// Lock-free single-producer/single-consumer ring. The producer checks
+// freeSlots() before push(); the consumer drains with pop(). Positions
+// only grow, so full and empty never look alike.
+template <typename T>
+class SpscRing {
+private:
+    vector<T> slots;
+    size_t mask;  // slots.size() - 1, a power of two minus one
+    alignas(64) atomic<size_t> readPos{ 0 };   // Advanced by the consumer
+    alignas(64) atomic<size_t> writePos{ 0 };  // Advanced by the producer
+
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size *= 2;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    // Producer side
+    size_t freeSlots() const {
+        return slots.size() - (writePos.load(memory_order_relaxed) - readPos.load(memory_order_acquire));
+    }
+    void push(const T& item) {
+        size_t w = writePos.load(memory_order_relaxed);
+        slots[w & mask] = item;
+        writePos.store(w + 1, memory_order_release);
+    }
+
+    // Consumer side
+    size_t pop(T* out, size_t maxItems) {
+        size_t r = readPos.load(memory_order_relaxed);
+        size_t n = min(maxItems, writePos.load(memory_order_acquire) - r);
+        for (size_t i = 0; i < n; i++) {
+            out[i] = slots[(r + i) & mask];
+        }
+        readPos.store(r + n, memory_order_release);
+        return n;
+    }
+};
+
+// Slab allocator for variable-height skip list towers. Blocks are carved
+// from 64 KB slabs and recycled through one free list per tower height, so
+// a node costs a single pointer bump and sits on one or two cache lines.
+class TowerPool {
+private:
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    vector<unique_ptr<char[]>> slabs;
+    size_t slabUsed = 0;
+    size_t slabCapacity = 0;
+    vector<FreeBlock*> freeByHeight;
+
+public:
+    explicit TowerPool(int maxHeight) : freeByHeight(maxHeight + 1, nullptr) {}
+
+    // `bytes` must be the same for every block of a given height
+    void* allocate(int height, size_t bytes) {
+        if (FreeBlock* block = freeByHeight[height]) {
+            freeByHeight[height] = block->next;
+            return block;
+        }
+        if (slabUsed + bytes > slabCapacity) {
+            slabCapacity = max(SLAB_SIZE, bytes);
+            slabs.emplace_back(new char[slabCapacity]);
+            slabUsed = 0;
+        }
+        void* result = slabs.back().get() + slabUsed;
+        slabUsed += bytes;
+        return result;
+    }
+
+    void release(void* p, int height) {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeByHeight[height];
+        freeByHeight[height] = block;
+    }
+};
+
+// xorshift64* generator; each board owns one so level draws are cheap,
+// lock-free and reproducible from an explicit seed
+class XorShift64 {
+private:
+    uint64_t state;
+
+public:
+    explicit XorShift64(uint64_t seed) {
+        // splitmix64 scramble so small or zero seeds still give a good state
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        state = (z ^ (z >> 31)) | 1;
+    }
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+};
+
+// On-disk Leaderboard snapshot: header, then `count` entries in ranking
+// order so a restore can link them without searching. Native-endian,
+// fixed-width fields, like the PlayerTable snapshot.
+static const char LEADERBOARD_SNAPSHOT_MAGIC[8] = { 'A', 'R', 'C', 'L', 'B', 'R', 'D', '1' };
+
+struct LeaderboardSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    double promotion;  // Promotion probability p of the saved board
+};
+
+struct LeaderboardSnapshotEntry {
+    int32_t score;
+    int32_t playerID;
+};
+
+class ConcreteLeaderboard : public Leaderboard {
+private:
+    struct Node;
+
+    // next = forward link; span = rank distance it covers, or the number of
+    // nodes after this one when next is null
+    struct Link {
+        Node* next;
+        int span;
+    };
+
+    // The tower of level + 1 links is stored inline right after the header
+    struct alignas(Link) Node {
+        int playerID, score;
+        int level;
+
+        Link* tower() { return reinterpret_cast<Link*>(this + 1); }
+        Node*& next(int i) { return tower()[i].next; }
+        int& span(int i) { return tower()[i].span; }
+    };
+
+    // Hard ceiling on tower height; the head is allocated this tall
+    static const int MAX_LEVEL = 32;
+
+    TowerPool pool;
+    Node* head;
+    int currentLevel;  // Track current max level in use
+    int length = 0;
+
+    // Promotion happens when a draw falls below p * 2^64
+    uint64_t promoteBelow;
+    XorShift64 rng;
+    // Levels randomLevel may hand out: about log_{1/p}(length), raised as
+    // the board grows so large boards keep O(log n) search
+    int levelLimit = 1;
+    double growAt;
+    double growFactor;
+    double promotion;
+    unordered_map<int, Node*> nodeByID;  // Kept in sync with level 0
+
+    // Materialized prefix of the ranking for repeated getTopN calls. It
+    // covers the largest n requested so far (up to TOP_CACHE_LIMIT) and is
+    // patched in place by writes that land inside it.
+    static const int TOP_CACHE_LIMIT = 1024;
+    vector<int> topCache;  // IDs ranked 1..min(topCacheK, length)
+    int topCacheK = 0;     // 0 until the first cacheable getTopN
+
+    // Top-K rank change feed, enabled by watchTopK
+    struct RankFeed {
+        int k;
+        SpscRing<RankEvent> ring;
+        bool resyncPending = true;  // Consumer's view is stale; resend the top K
+
+        RankFeed(int topK, size_t capacity) : k(topK), ring(capacity) {}
+    };
+    unique_ptr<RankFeed> rankFeed;
+
+    static size_t nodeBytes(int level) {
+        return sizeof(Node) + (level + 1) * sizeof(Link);
+    }
+    Node* createNode(int id, int score, int level) {
+        Node* node = static_cast<Node*>(pool.allocate(level, nodeBytes(level)));
+        node->playerID = id;
+        node->score = score;
+        node->level = level;
+        for (int i = 0; i <= level; i++) {
+            node->tower()[i] = { nullptr, 0 };
+        }
+        return node;
+    }
+    void destroyNode(Node* node) {
+        pool.release(node, node->level);
+    }
+    // Helper to compare two nodes based on requirements
+    // Primary: higher score comes first, Secondary: lower ID comes first for same score
+    bool shouldPlaceBefore(Node* a, Node* b) {
+        if (!b) return true; // NULL comes at the end
+        if (a->score > b->score) return true;
+        if (a->score == b->score && a->playerID < b->playerID) return true;
+        return false;
+    }
+    int randomLevel() {
+        int level = 0;
+        while (level < levelLimit && rng.next() < promoteBelow) {
+            level++;
+        }
+        return level;
+    }
+    Node* findNodeByID(int playerID) {
+        auto it = nodeByID.find(playerID);
+        return it == nodeByID.end() ? nullptr : it->second;
+    }
+    void growLevelLimit() {
+        while (length >= growAt && levelLimit < MAX_LEVEL) {
+            levelLimit++;
+            growAt *= growFactor;
+        }
+    }
+    // Returns every node to the pool and resets to an empty board
+    void clear() {
+        Node* curr = head->next(0);
+        while (curr) {
+            Node* next = curr->next(0);
+            destroyNode(curr);
+            curr = next;
+        }
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            head->tower()[i] = { nullptr, 0 };
+        }
+        currentLevel = 0;
+        length = 0;
+        levelLimit = 1;
+        growAt = growFactor;
+        nodeByID.clear();
+        topCache.clear();
+        topCacheK = 0;
+    }
+    // Links (score, playerID) entries that are already in ranking order into
+    // an empty board in one pass. Levels are deterministic: with b = 1/p
+    // rounded, the node at rank r rises one level per factor of b in r,
+    // which gives every level an evenly spaced 1/b of the level below.
+    void buildFromRanked(const vector<pair<int, int>>& ranked) {
+        length = (int)ranked.size();
+        growLevelLimit();
+        int base = max(2, (int)lround(growFactor));
+
+        Node* last[MAX_LEVEL + 1];
+        int lastRank[MAX_LEVEL + 1];
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            last[i] = head;
+            lastRank[i] = 0;
+        }
+        nodeByID.reserve(ranked.size());
+
+        for (int rank = 1; rank <= length; rank++) {
+            int level = 0;
+            for (int r = rank; r % base == 0 && level < levelLimit; r /= base) {
+                level++;
+            }
+            Node* node = createNode(ranked[rank - 1].second, ranked[rank - 1].first, level);
+            if (!nodeByID.emplace(node->playerID, node).second) {
+                destroyNode(node);
+                throw "Duplicate player in ranked entries";
+            }
+            for (int i = 0; i <= level; i++) {
+                last[i]->next(i) = node;
+                last[i]->span(i) = rank - lastRank[i];
+                last[i] = node;
+                lastRank[i] = rank;
+            }
+            currentLevel = max(currentLevel, level);
+        }
+        for (int i = 0; i <= currentLevel; i++) {
+            last[i]->next(i) = nullptr;
+            last[i]->span(i) = length - lastRank[i];
+        }
+    }
+    // Number of leading nodes for which `before` holds; `before` must be
+    // true for a prefix of the ranking and false afterwards
+    template <typename Pred>
+    int countPrefix(Pred before) {
+        Node* curr = head;
+        int rank = 0;
+        for (int i = currentLevel; i >= 0; i--) {
+            while (curr->next(i) && before(curr->next(i))) {
+                rank += curr->span(i);
+                curr = curr->next(i);
+            }
+        }
+        return rank;
+    }
+    void ensureTopCache(int n) {
+        if (n <= topCacheK) return;
+        topCacheK = n;
+        topCache.clear();
+        topCache.reserve(n);
+        for (Node* curr = head->next(0); curr && (int)topCache.size() < n; curr = curr->next(0)) {
+            topCache.push_back(curr->playerID);
+        }
+    }
+    // Called after a node was linked in at `rank`
+    void patchTopCacheInsert(int rank, int playerID) {
+        if (rank > topCacheK) return;
+        topCache.insert(topCache.begin() + (rank - 1), playerID);
+        if ((int)topCache.size() > topCacheK) topCache.pop_back();
+    }
+    // Called after the node at `rank` was unlinked
+    void patchTopCacheRemove(int rank) {
+        if (rank > (int)topCache.size()) return;
+        topCache.erase(topCache.begin() + (rank - 1));
+        if (length >= topCacheK) topCache.push_back(nodeAtRank(topCacheK)->playerID);
+    }
+    // Replays the whole top K as RESYNC + ENTERED events once the ring has
+    // room for all of them
+    void publishResync() {
+        int count = min(rankFeed->k, length);
+        if (rankFeed->ring.freeSlots() < (size_t)count + 1) return;
+        rankFeed->ring.push({ RANK_RESYNC, -1, 0, rankFeed->k });
+        int rank = 1;
+        for (Node* curr = head->next(0); rank <= count; curr = curr->next(0), rank++) {
+            rankFeed->ring.push({ RANK_ENTERED, curr->playerID, 0, rank });
+        }
+        rankFeed->resyncPending = false;
+    }
+    // Emits the top-K effect of a player going from oldRank to newRank
+    // (0 = absent). Besides the player's own event, at most one other
+    // player crosses the K boundary; everyone else only shifts by one,
+    // which the consumer infers from the events' ranks.
+    void publishRankChange(int playerID, int oldRank, int newRank) {
+        if (rankFeed->resyncPending) {
+            publishResync();
+            return;
+        }
+        int k = rankFeed->k;
+        bool wasIn = oldRank > 0 && oldRank <= k;
+        bool isIn = newRank > 0 && newRank <= k;
+        RankEvent events[2];
+        int count = 0;
+        if (wasIn && isIn) {
+            if (oldRank != newRank) events[count++] = { RANK_MOVED, playerID, oldRank, newRank };
+        }
+        else if (wasIn) {
+            events[count++] = { RANK_LEFT, playerID, oldRank, 0 };
+            if (Node* pulledIn = nodeAtRank(k)) events[count++] = { RANK_ENTERED, pulledIn->playerID, 0, k };
+        }
+        else if (isIn) {
+            if (Node* pushedOut = nodeAtRank(k + 1)) events[count++] = { RANK_LEFT, pushedOut->playerID, k, 0 };
+            events[count++] = { RANK_ENTERED, playerID, 0, newRank };
+        }
+        if (count == 0) return;
+        if (rankFeed->ring.freeSlots() < (size_t)count) {
+            rankFeed->resyncPending = true;  // Drop; the consumer gets a full resend later
+            return;
+        }
+        for (int i = 0; i < count; i++) {
+            rankFeed->ring.push(events[i]);
+        }
+    }
+    // Unlinks an indexed node and returns the rank it had
+    int unlinkNode(Node* target) {
+        int playerID = target->playerID;
+        int targetScore = target->score;
+        Node* current = head;
+        int rank = 0;  // Rank of current
+
+        // Walk down using the SAME comparison as insertion; at each level the
+        // last node before the target is its predecessor there
+        for (int i = currentLevel; i >= 0; i--) {
+            // Use proper comparison: higher scores first, then lower IDs for same score
+            while (current->next(i) &&
+                (current->next(i)->score > targetScore ||
+                    (current->next(i)->score == targetScore &&
+                        current->next(i)->playerID < playerID))) {
+                rank += current->span(i);
+                current = current->next(i);
+            }
+            if (i <= target->level && current->next(i) == target) {
+                current->span(i) += target->span(i) - 1;
+                current->next(i) = target->next(i);
+            }
+            else {
+                current->span(i)--;
+            }
+        }
+
+        length--;
+        nodeByID.erase(playerID);
+        destroyNode(target);
+        patchTopCacheRemove(rank + 1);
+
+        // Update currentLevel
+        while (currentLevel > 0 && head->next(currentLevel) == nullptr) {
+            currentLevel--;
+        }
+        return rank + 1;
+    }
+    Node* nodeAtRank(int rank) {
+        if (rank < 1 || rank > length) return nullptr;
+        Node* curr = head;
+        int traversed = 0;
+        for (int i = currentLevel; i >= 0; i--) {
+            while (curr->next(i) && traversed + curr->span(i) <= rank) {
+                traversed += curr->span(i);
+                curr = curr->next(i);
+            }
+        }
+        return curr;
+    }
+
+public:
+    ConcreteLeaderboard(double p = 0.5, uint64_t seed = (uint64_t)time(0)) : pool(MAX_LEVEL), rng(seed) {
+        if (!(p > 0.0 && p < 1.0)) {
+            throw "Promotion probability must be in (0, 1)";
+        }
+        promoteBelow = (uint64_t)(p * 18446744073709551616.0);
+        promotion = p;
+        growFactor = 1.0 / p;
+        growAt = growFactor;
+        currentLevel = 0;
+        head = createNode(-1, INT_MIN, MAX_LEVEL);  // Dummy head with lowest possible score
+    }
+
+    // Nodes are trivially destructible; the pool frees their slabs
+    ~ConcreteLeaderboard() {}
+
+    void addScore(int playerID, int score) override {
+        // Nothing moves if the score is unchanged
+        Node* existing = findNodeByID(playerID);
+        if (existing && existing->score == score) {
+            return;
+        }
+        // Remove existing player first
+        int oldRank = existing ? unlinkNode(existing) : 0;
+
+        // Generate random level
+        int level = randomLevel();
+
+        // Update current level if needed
+        if (level > currentLevel) {
+            for (int i = currentLevel + 1; i <= level; i++) {
+                head->next(i) = nullptr;
+                head->span(i) = length;
+            }
+            currentLevel = level;
+        }
+
+        // Create new node
+        Node* newNode = createNode(playerID, score, level);
+        Node* curr = head;
+        int rank = 0;  // Rank of curr
+        Node* update[MAX_LEVEL + 1];
+        int rankAt[MAX_LEVEL + 1];
+
+        // Find the predecessor at each level, tracking how far along it is
+        for (int i = currentLevel; i >= 0; i--) {
+            // CORRECTED: Proper tie-breaking
+            // Move while next node has HIGHER score OR same score with LOWER ID
+            while (curr->next(i) &&
+                (curr->next(i)->score > score ||
+                    (curr->next(i)->score == score && curr->next(i)->playerID < playerID))) {
+                rank += curr->span(i);
+                curr = curr->next(i);
+            }
+            update[i] = curr;
+            rankAt[i] = rank;
+        }
+
+        // Link in, splitting the predecessor's span around the new node;
+        // links passing over it from higher levels grow by one
+        for (int i = 0; i <= currentLevel; i++) {
+            if (i <= level) {
+                newNode->next(i) = update[i]->next(i);
+                update[i]->next(i) = newNode;
+                newNode->span(i) = update[i]->span(i) - (rank - rankAt[i]);
+                update[i]->span(i) = rank - rankAt[i] + 1;
+            }
+            else {
+                update[i]->span(i)++;
+            }
+        }
+        length++;
+        nodeByID[playerID] = newNode;
+        patchTopCacheInsert(rank + 1, playerID);
+        growLevelLimit();
+        if (rankFeed) publishRankChange(playerID, oldRank, rank + 1);
+    }
+
+    void removePlayer(int playerID) override {
+        // Find the node and its score through the ID index
+        Node* target = findNodeByID(playerID);
+        if (!target) return;  // Player not found
+
+        int oldRank = unlinkNode(target);
+        if (rankFeed) publishRankChange(playerID, oldRank, 0);
+    }
+
+    vector<int> getTopN(int n) override {
+        if (n <= 0) return vector<int>();
+        if (n <= TOP_CACHE_LIMIT) {
+            ensureTopCache(n);
+            return vector<int>(topCache.begin(), topCache.begin() + min(n, (int)topCache.size()));
+        }
+        vector<int> result;
+        Node* curr = head->next(0);
+        while (curr && result.size() < n) {
+            result.push_back(curr->playerID);
+            curr = curr->next(0);
+        }
+
+        return result;
+    }
+
+    int getTopN(int n, int* out) override {
+        if (n <= 0) return 0;
+        if (n <= TOP_CACHE_LIMIT) {
+            ensureTopCache(n);
+            int count = min(n, (int)topCache.size());
+            copy(topCache.begin(), topCache.begin() + count, out);
+            return count;
+        }
+        int count = 0;
+        for (Node* curr = head->next(0); curr && count < n; curr = curr->next(0)) {
+            out[count++] = curr->playerID;
+        }
+        return count;
+    }
+
+    // Merges (playerID, score) entries into the board as if by addScore in
+    // order (later entries for a player win), but sorts once and relinks
+    // the whole list in O(n) instead of searching per entry
+    void bulkLoad(const vector<pair<int, int>>& entries) override {
+        unordered_map<int, int> latest;
+        latest.reserve(length + entries.size());
+        for (Node* curr = head->next(0); curr; curr = curr->next(0)) {
+            latest[curr->playerID] = curr->score;
+        }
+        for (const auto& entry : entries) {
+            latest[entry.first] = entry.second;
+        }
+
+        vector<pair<int, int>> ranked;  // (score, playerID)
+        ranked.reserve(latest.size());
+        for (const auto& entry : latest) {
+            ranked.push_back({ entry.second, entry.first });
+        }
+        sort(ranked.begin(), ranked.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+
+        clear();
+        buildFromRanked(ranked);
+        if (rankFeed) {
+            rankFeed->resyncPending = true;
+            publishResync();
+        }
+    }
+
+    void watchTopK(int k, int capacity) override {
+        if (k < 1) throw "Watched top K must be positive";
+        // Room for a full resend plus the events that follow it
+        rankFeed.reset(new RankFeed(k, max<size_t>(capacity, 2 * ((size_t)k + 1))));
+        publishResync();
+    }
+
+    int pollRankEvents(RankEvent* out, int maxEvents) override {
+        if (!rankFeed) throw "Rank feed not enabled";
+        return (int)rankFeed->ring.pop(out, max(0, maxEvents));
+    }
+
+    void saveSnapshot(const string& path) override {
+        LeaderboardSnapshotHeader header;
+        memcpy(header.magic, LEADERBOARD_SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = 1;
+        header.count = (uint32_t)length;
+        header.promotion = promotion;
+
+        vector<LeaderboardSnapshotEntry> entries;
+        entries.reserve(length);
+        for (Node* curr = head->next(0); curr; curr = curr->next(0)) {
+            entries.push_back({ curr->score, curr->playerID });
+        }
+
+        ofstream out(path, ios::binary | ios::trunc);
+        if (!out) {
+            throw "Cannot write snapshot";
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(LeaderboardSnapshotEntry));
+        if (!out) {
+            throw "Cannot write snapshot";
+        }
+    }
+
+    // Board rebuilt from a file written by saveSnapshot
+    static ConcreteLeaderboard* loadSnapshot(const string& path) {
+        ifstream in(path, ios::binary);
+        LeaderboardSnapshotHeader header;
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            memcmp(header.magic, LEADERBOARD_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != 1 || header.count > (uint32_t)INT_MAX) {
+            throw "Not a leaderboard snapshot";
+        }
+        // Check the count against the file before sizing anything from it
+        streamoff bodyStart = in.tellg();
+        in.seekg(0, ios::end);
+        streamoff bodyBytes = in.tellg() - bodyStart;
+        in.seekg(bodyStart);
+        if (!in || bodyBytes != (streamoff)header.count * (streamoff)sizeof(LeaderboardSnapshotEntry)) {
+            throw "Leaderboard snapshot size does not match its count";
+        }
+        vector<LeaderboardSnapshotEntry> entries(header.count);
+        if (!in.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(LeaderboardSnapshotEntry))) {
+            throw "Truncated leaderboard snapshot";
+        }
+
+        vector<pair<int, int>> ranked(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            ranked[i] = { entries[i].score, entries[i].playerID };
+            if (i > 0 && !(ranked[i - 1].first > ranked[i].first ||
+                (ranked[i - 1].first == ranked[i].first && ranked[i - 1].second < ranked[i].second))) {
+                throw "Leaderboard snapshot is not in ranking order";
+            }
+        }
+
+        unique_ptr<ConcreteLeaderboard> board(new ConcreteLeaderboard(header.promotion));
+        board->buildFromRanked(ranked);
+        return board.release();
+    }
+
+    // Current score of the player, if present
+    bool findScore(int playerID, int& score) {
+        Node* node = findNodeByID(playerID);
+        if (!node) return false;
+        score = node->score;
+        return true;
+    }
+
+    // Players ranked ahead of a (possibly absent) entry with this key
+    int countBefore(int score, int playerID) {
+        return countPrefix([score, playerID](Node* n) {
+            return n->score > score || (n->score == score && n->playerID < playerID);
+        });
+    }
+
+    // Appends (score, playerID) of the top n players, in ranking order
+    void appendTopEntries(int n, vector<pair<int, int>>& out) {
+        for (Node* curr = head->next(0); curr && n > 0; curr = curr->next(0), n--) {
+            out.push_back({ curr->score, curr->playerID });
+        }
+    }
+
+    void appendEntriesInScoreRange(int minScore, int maxScore, vector<pair<int, int>>& out) {
+        if (minScore > maxScore) return;
+        Node* curr = head;
+        for (int i = currentLevel; i >= 0; i--) {
+            while (curr->next(i) && curr->next(i)->score > maxScore) {
+                curr = curr->next(i);
+            }
+        }
+        for (curr = curr->next(0); curr && curr->score >= minScore; curr = curr->next(0)) {
+            out.push_back({ curr->score, curr->playerID });
+        }
+    }
+
+    int getRank(int playerID) override {
+        Node* target = findNodeByID(playerID);
+        if (!target) return -1;
+        return countPrefix([target](Node* n) {
+            return n->score > target->score ||
+                (n->score == target->score && n->playerID <= target->playerID);
+        });
+    }
+
+    int getByRank(int rank) override {
+        Node* node = nodeAtRank(rank);
+        return node ? node->playerID : -1;
+    }
+
+    vector<int> getPlayersAroundRank(int rank, int radius) override {
+        vector<int> result;
+        int first = max(1, rank - radius);
+        int last = min(length, rank + radius);
+        Node* curr = nodeAtRank(first);
+        for (int r = first; curr && r <= last; r++) {
+            result.push_back(curr->playerID);
+            curr = curr->next(0);
+        }
+        return result;
+    }
+
+    int countInScoreRange(int minScore, int maxScore) override {
+        if (minScore > maxScore) return 0;
+        int atLeastMin = countPrefix([minScore](Node* n) { return n->score >= minScore; });
+        int aboveMax = countPrefix([maxScore](Node* n) { return n->score > maxScore; });
+        return atLeastMin - aboveMax;
+    }
+
+    double percentile(int score) override {
+        if (length == 0) return 0.0;
+        int atLeast = countPrefix([score](Node* n) { return n->score >= score; });
+        return 100.0 * (length - atLeast) / length;
+    }
+
+    int scoreAtPercentile(double pct) override {
+        if (length == 0) throw "Leaderboard is empty";
+        return nodeAtRank(length - percentilePosition(pct, length) + 1)->score;
+    }
+
+    vector<int> getPlayersInScoreRange(int minScore, int maxScore) override {
+        vector<int> result;
+        if (minScore > maxScore) return result;
+        // Descend to the last node scoring above the range, then walk level 0
+        Node* curr = head;
+        for (int i = currentLevel; i >= 0; i--) {
+            while (curr->next(i) && curr->next(i)->score > maxScore) {
+                curr = curr->next(i);
+            }
+        }
+        for (curr = curr->next(0); curr && curr->score >= minScore; curr = curr->next(0)) {
+            result.push_back(curr->playerID);
+        }
+        return result;
+    }
+};
+
+// --- 2b. ConcurrentLeaderboard (Lazy Skip List + Epoch Reclamation) ---
+
+static const int MAX_EPOCH_THREADS = 256;
+
+// Dense per-thread indices in [0, MAX_EPOCH_THREADS). A thread claims the
+// lowest free index on first use and hands it back when it exits, so
+// per-thread arrays stay small however many threads come and go.
+class ThreadSlots {
+private:
+    struct Registry {
+        mutex lock;
+        vector<bool> used = vector<bool>(MAX_EPOCH_THREADS, false);
+        atomic<int> highWater{ 0 };  // One past the largest index ever claimed
+    };
+
+    static Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    struct Holder {
+        int index = -1;
+
+        Holder() {
+            Registry& r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for (int i = 0; i < MAX_EPOCH_THREADS && index < 0; i++) {
+                if (!r.used[i]) index = i;
+            }
+            if (index < 0) throw "Too many threads";
+            r.used[index] = true;
+            if (index >= r.highWater.load()) r.highWater.store(index + 1);
+        }
+
+        ~Holder() {
+            Registry& r = registry();
+            lock_guard<mutex> guard(r.lock);
+            r.used[index] = false;
+        }
+    };
+
+public:
+    static int current() {
+        thread_local Holder holder;
+        return holder.index;
+    }
+
+    static int highWater() {
+        return registry().highWater.load(memory_order_acquire);
+    }
+};
+
+// Epoch-based reclamation for structures whose readers take no locks.
+// Every operation runs inside a Guard that announces the epoch it started
+// in. A retired block is freed once the global epoch has advanced twice
+// past its retirement; by then every guard that could still reach it has
+// ended. Each thread retires into its own slot, so retire() takes no lock.
+class EpochReclaimer {
+private:
+    static const size_t RECLAIM_BATCH = 64;
+
+    struct alignas(64) Slot {
+        atomic<uint64_t> announced{ 0 };  // (epoch << 1) | 1 while inside a guard
+        vector<pair<uint64_t, void*>> limbo;  // (retire epoch, block); owner thread only
+        size_t reclaimAt = RECLAIM_BATCH;
+    };
+
+    atomic<uint64_t> globalEpoch{ 1 };
+    unique_ptr<Slot[]> slots;
+    void (*freeBlock)(void*);
+
+    // Advances the epoch if every active guard has seen the current one
+    void tryAdvance() {
+        uint64_t epoch = globalEpoch.load();
+        int count = ThreadSlots::highWater();
+        for (int i = 0; i < count; i++) {
+            uint64_t a = slots[i].announced.load();
+            if ((a & 1) && (a >> 1) != epoch) return;
+        }
+        globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void reclaim(Slot& slot) {
+        tryAdvance();
+        uint64_t epoch = globalEpoch.load();
+        size_t kept = 0;
+        for (auto& entry : slot.limbo) {
+            if (entry.first + 2 <= epoch) {
+                freeBlock(entry.second);
+            }
+            else {
+                slot.limbo[kept++] = entry;
+            }
+        }
+        slot.limbo.resize(kept);
+        // A stalled reader pins the epoch; back off instead of rescanning
+        // the same survivors on every retire
+        slot.reclaimAt = kept + RECLAIM_BATCH;
+    }
+
+public:
+    explicit EpochReclaimer(void (*freeFn)(void*))
+        : slots(new Slot[MAX_EPOCH_THREADS]), freeBlock(freeFn) {
+    }
+
+    // Only safe once no guard is active
+    ~EpochReclaimer() {
+        for (int i = 0; i < MAX_EPOCH_THREADS; i++) {
+            for (auto& entry : slots[i].limbo) freeBlock(entry.second);
+        }
+    }
+
+    // Not reentrant: one guard per thread at a time
+    class Guard {
+    private:
+        Slot& slot;
+
+    public:
+        explicit Guard(EpochReclaimer& owner) : slot(owner.slots[ThreadSlots::current()]) {
+            slot.announced.store((owner.globalEpoch.load() << 1) | 1);
+            // The announcement must be visible before any shared pointer is read
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+
+        ~Guard() {
+            slot.announced.store(0, memory_order_release);
+        }
+    };
+
+    // Call inside a Guard, after the block has been unlinked
+    void retire(void* block) {
+        Slot& slot = slots[ThreadSlots::current()];
+        slot.limbo.push_back({ globalEpoch.load(), block });
+        if (slot.limbo.size() >= slot.reclaimAt) reclaim(slot);
+    }
+};
+
+// Thread-safe Leaderboard built on a lazy skip list (Herlihy et al.).
+// getTopN and the other readers traverse without taking any lock and skip
+// nodes that are marked or not yet fully linked. Writers lock only the
+// predecessors they relink and validate them before writing. Unlinked
+// nodes are freed through the EpochReclaimer, so a reader can never touch
+// freed memory. Updates to the same player are serialized by a sharded
+// playerID -> node index. A score change marks the old node before it
+// links the new one, and getTopN drops IDs it has already emitted, so a
+// player is never listed twice. A reader that passes the new position
+// before it is linked and reaches the old node after it is marked misses
+// that player for that one call.
+class ConcurrentLeaderboard : public Leaderboard {
+private:
+    struct alignas(void*) Node {
+        int playerID, score;
+        int level;
+        atomic<bool> marked{ false };       // Logically removed
+        atomic<bool> fullyLinked{ false };  // Linked at every level
+        atomic<bool> locked{ false };
+
+        // The tower of level + 1 links is stored inline after the header
+        atomic<Node*>& next(int i) { return reinterpret_cast<atomic<Node*>*>(this + 1)[i]; }
+
+        void lock() {
+            while (locked.exchange(true, memory_order_acquire)) this_thread::yield();
+        }
+        void unlock() {
+            locked.store(false, memory_order_release);
+        }
+    };
+
+    struct alignas(64) IndexShard {
+        mutex lock;
+        unordered_map<int, Node*> nodes;
+    };
+
+    static const int MAX_LEVEL = 24;
+    static const int INDEX_SHARDS = 64;
+
+    EpochReclaimer reclaimer;
+    Node* head;
+    atomic<int> topLevel{ 0 };  // Highest level any node has used; never shrinks
+    vector<unique_ptr<IndexShard>> shards;
+
+    static Node* createNode(int id, int score, int level) {
+        void* memory = ::operator new(sizeof(Node) + (level + 1) * sizeof(atomic<Node*>));
+        Node* node = new (memory) Node();
+        node->playerID = id;
+        node->score = score;
+        node->level = level;
+        for (int i = 0; i <= level; i++) {
+            new (&node->next(i)) atomic<Node*>(nullptr);
+        }
+        return node;
+    }
+    static void freeNode(void* node) {
+        ::operator delete(node);
+    }
+    // Primary: higher score comes first, Secondary: lower ID comes first for same score
+    static bool placedBefore(Node* n, int score, int playerID) {
+        return n->score > score || (n->score == score && n->playerID < playerID);
+    }
+    static int randomLevel() {
+        thread_local XorShift64 rng(hash<thread::id>()(this_thread::get_id()));
+        int level = 0;
+        while (level < MAX_LEVEL && (rng.next() >> 63)) {
+            level++;
+        }
+        return level;
+    }
+    IndexShard& shardFor(int playerID) {
+        unsigned int h = (unsigned int)playerID * 2654435769u;
+        return *shards[(h >> 16) & (INDEX_SHARDS - 1)];
+    }
+
+    // Fills preds/succs around the key for every level from the top down,
+    // and at least for levels [0, level]
+    void find(int score, int playerID, int level, Node** preds, Node** succs) {
+        Node* pred = head;
+        for (int i = max(topLevel.load(memory_order_acquire), level); i >= 0; i--) {
+            Node* curr = pred->next(i).load(memory_order_acquire);
+            while (curr && placedBefore(curr, score, playerID)) {
+                pred = curr;
+                curr = pred->next(i).load(memory_order_acquire);
+            }
+            preds[i] = pred;
+            succs[i] = curr;
+        }
+    }
+
+    // Locks preds[0..level] bottom-up, skipping repeats (a node that is the
+    // predecessor on several levels appears in consecutive entries).
+    // Returns the highest level locked.
+    template <typename Check>
+    static int lockPreds(Node** preds, int level, bool& valid, Check check) {
+        int i = 0;
+        for (; valid && i <= level; i++) {
+            if (i == 0 || preds[i] != preds[i - 1]) preds[i]->lock();
+            valid = check(i);
+        }
+        return i - 1;
+    }
+    static void unlockPreds(Node** preds, int lockedUpTo) {
+        for (int i = 0; i <= lockedUpTo; i++) {
+            if (i == 0 || preds[i] != preds[i - 1]) preds[i]->unlock();
+        }
+    }
+
+    // Keys (score, playerID) are unique: the caller holds the player's index
+    // shard, and any earlier node for the player is already unlinked
+    Node* insertNode(int playerID, int score) {
+        int level = randomLevel();
+        int top = topLevel.load();
+        while (top < level && !topLevel.compare_exchange_weak(top, level)) {}
+
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+        while (true) {
+            find(score, playerID, level, preds, succs);
+            bool valid = true;
+            int locked = lockPreds(preds, level, valid, [&](int i) {
+                return !preds[i]->marked.load() &&
+                    (!succs[i] || !succs[i]->marked.load()) &&
+                    preds[i]->next(i).load() == succs[i];
+            });
+            if (!valid) {
+                unlockPreds(preds, locked);
+                continue;
+            }
+
+            Node* node = createNode(playerID, score, level);
+            for (int i = 0; i <= level; i++) {
+                node->next(i).store(succs[i], memory_order_relaxed);
+            }
+            for (int i = 0; i <= level; i++) {
+                preds[i]->next(i).store(node, memory_order_release);
+            }
+            node->fullyLinked.store(true, memory_order_release);
+            unlockPreds(preds, locked);
+            return node;
+        }
+    }
+
+    // The caller holds the player's index shard and an epoch guard
+    void removeNode(Node* victim) {
+        // Once marked under its own lock, nothing links after the victim,
+        // so its next pointers stay fixed while it is unlinked
+        victim->lock();
+        victim->marked.store(true, memory_order_release);
+        int level = victim->level;
+
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+        while (true) {
+            find(victim->score, victim->playerID, level, preds, succs);
+            bool valid = true;
+            int locked = lockPreds(preds, level, valid, [&](int i) {
+                return !preds[i]->marked.load() && preds[i]->next(i).load() == victim;
+            });
+            if (!valid) {
+                unlockPreds(preds, locked);
+                continue;
+            }
+
+            for (int i = level; i >= 0; i--) {
+                preds[i]->next(i).store(victim->next(i).load(memory_order_relaxed), memory_order_release);
+            }
+            unlockPreds(preds, locked);
+            break;
+        }
+        victim->unlock();
+        reclaimer.retire(victim);
+    }
+
+public:
+    ConcurrentLeaderboard() : reclaimer(freeNode) {
+        head = createNode(-1, INT_MIN, MAX_LEVEL);
+        head->fullyLinked.store(true);
+        for (int i = 0; i < INDEX_SHARDS; i++) {
+            shards.emplace_back(new IndexShard());
+        }
+    }
+
+    // Callers must have stopped every other thread using the board
+    ~ConcurrentLeaderboard() {
+        Node* curr = head->next(0).load();
+        while (curr) {
+            Node* next = curr->next(0).load();
+            freeNode(curr);
+            curr = next;
+        }
+        freeNode(head);
+    }
+
+    void addScore(int playerID, int score) override {
+        IndexShard& shard = shardFor(playerID);
+        lock_guard<mutex> guard(shard.lock);
+        EpochReclaimer::Guard epoch(reclaimer);
+
+        auto it = shard.nodes.find(playerID);
+        if (it != shard.nodes.end()) {
+            if (it->second->score == score) return;
+            removeNode(it->second);
+        }
+        shard.nodes[playerID] = insertNode(playerID, score);
+    }
+
+    void removePlayer(int playerID) override {
+        IndexShard& shard = shardFor(playerID);
+        lock_guard<mutex> guard(shard.lock);
+        EpochReclaimer::Guard epoch(reclaimer);
+
+        auto it = shard.nodes.find(playerID);
+        if (it == shard.nodes.end()) return;
+        removeNode(it->second);
+        shard.nodes.erase(it);
+    }
+
+    using Leaderboard::getTopN;
+
+    vector<int> getTopN(int n) override {
+        EpochReclaimer::Guard epoch(reclaimer);
+        vector<int> result;
+        // A player moving during the walk can be seen at both positions
+        unordered_set<int> emitted;
+        Node* curr = head->next(0).load(memory_order_acquire);
+        while (curr && (int)result.size() < n) {
+            if (curr->fullyLinked.load(memory_order_acquire) && !curr->marked.load(memory_order_acquire) &&
+                emitted.insert(curr->playerID).second) {
+                result.push_back(curr->playerID);
+            }
+            curr = curr->next(0).load(memory_order_acquire);
+        }
+        return result;
+    }
+};
+
+// --- 2c. BufferedLeaderboard (Coalescing Write Buffer) ---
+
+// Leaderboard decorator that logs updates instead of repositioning a node
+// per call. Pending updates are coalesced per player and applied to the
+// underlying skip list on flush(), before any read, or once the buffer
+// reaches its size limit. In additive mode addScore adds to the player's
+// current score (0 for new players); otherwise the last write wins,
+// matching ConcreteLeaderboard.
+class BufferedLeaderboard : public Leaderboard {
+private:
+    struct PendingUpdate {
+        bool present;     // False: the player ends up removed
+        bool resetFirst;  // Removed earlier in this batch: ignore the old score
+        long long value;  // Final score, or the summed delta when additive
+    };
+
+    ConcreteLeaderboard board;
+    bool additive;
+    size_t flushThreshold;
+    unordered_map<int, PendingUpdate> pending;
+
+    void flushIfFull() {
+        if (pending.size() >= flushThreshold) flush();
+    }
+
+public:
+    BufferedLeaderboard(bool additiveUpdates, size_t threshold = 4096)
+        : additive(additiveUpdates), flushThreshold(threshold) {
+        pending.reserve(threshold);
+    }
+
+    void addScore(int playerID, int score) override {
+        auto it = pending.find(playerID);
+        if (it == pending.end()) {
+            pending[playerID] = { true, false, score };
+            flushIfFull();
+        }
+        else if (additive && it->second.present) {
+            it->second.value += score;
+        }
+        else {
+            // Last write wins, or the first add after a buffered removal
+            it->second.present = true;
+            it->second.value = score;
+        }
     }
 
-    // Combined double hash for probing
-    int doubleHash(int key, int attempt) {
-        return (hash1(key) + attempt * hash2(key)) % TABLE_SIZE;
+    void removePlayer(int playerID) override {
+        pending[playerID] = { false, true, 0 };
+        flushIfFull();
     }
-    int findIndex(int playerID) {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            int index = doubleHash(playerID, i);
-            //insert
-            if (!table[index].occupied || table[index].playerID == playerID) {
-                return index;
+
+    // Applies the buffer: removals first, then insertions in ranking order
+    // so consecutive descents walk neighbouring towers
+    void flush() override {
+        if (pending.empty()) return;
+
+        vector<pair<int, int>> writes;  // (score, playerID)
+        writes.reserve(pending.size());
+        for (const auto& entry : pending) {
+            int playerID = entry.first;
+            const PendingUpdate& update = entry.second;
+            if (!update.present) {
+                board.removePlayer(playerID);
+                continue;
+            }
+            long long score = update.value;
+            int current;
+            if (additive && !update.resetFirst && board.findScore(playerID, current)) {
+                score += current;
             }
+            score = max<long long>(INT_MIN, min<long long>(INT_MAX, score));
+            writes.push_back({ (int)score, playerID });
+        }
+        pending.clear();
+
+        sort(writes.begin(), writes.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+        for (const auto& write : writes) {
+            board.addScore(write.second, write.first);
         }
-        return -1;
     }
-    int findExistingIndex(int playerID) {
-        for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
-            int index = doubleHash(playerID, attempt);
 
-            // Empty slot means not found
-            if (!table[index].occupied) {
-                return -1;
-            }
+    vector<int> getTopN(int n) override {
+        flush();
+        return board.getTopN(n);
+    }
 
-            // Found and valid
-            if (table[index].occupied &&
-                table[index].playerID == playerID) {
-                return index;
-            }
+    int getTopN(int n, int* out) override {
+        flush();
+        return board.getTopN(n, out);
+    }
+
+    void saveSnapshot(const string& path) override {
+        flush();
+        board.saveSnapshot(path);
+    }
+
+    // Events are produced when the buffer is applied
+    void watchTopK(int k, int capacity) override {
+        board.watchTopK(k, capacity);
+    }
+
+    int pollRankEvents(RankEvent* out, int maxEvents) override {
+        return board.pollRankEvents(out, maxEvents);
+    }
+
+    int getRank(int playerID) override {
+        flush();
+        return board.getRank(playerID);
+    }
+
+    int getByRank(int rank) override {
+        flush();
+        return board.getByRank(rank);
+    }
+
+    vector<int> getPlayersAroundRank(int rank, int radius) override {
+        flush();
+        return board.getPlayersAroundRank(rank, radius);
+    }
+
+    int countInScoreRange(int minScore, int maxScore) override {
+        flush();
+        return board.countInScoreRange(minScore, maxScore);
+    }
+
+    vector<int> getPlayersInScoreRange(int minScore, int maxScore) override {
+        flush();
+        return board.getPlayersInScoreRange(minScore, maxScore);
+    }
+
+    double percentile(int score) override {
+        flush();
+        return board.percentile(score);
+    }
+
+    int scoreAtPercentile(double pct) override {
+        flush();
+        return board.scoreAtPercentile(pct);
+    }
+};
+
+// --- 2d. ShardedLeaderboard (Per-Shard Skip Lists + K-Way Merge) ---
+
+// (score, playerID) runs, each already in ranking order
+typedef vector<pair<int, int>> ScoreRun;
+
+// Merges ranking-ordered runs with a heap of run heads and returns up to
+// `limit` IDs. Ties keep the board-wide order: higher score, then lower ID.
+// With distinctIDs, only a player's first (best) entry is kept.
+static vector<int> mergeRuns(const vector<ScoreRun>& runs, int limit, bool distinctIDs = false) {
+    // (score, playerID, run, index); the top of the heap ranks first
+    typedef tuple<int, int, int, int> Head;
+    auto after = [](const Head& a, const Head& b) {
+        if (get<0>(a) != get<0>(b)) return get<0>(a) < get<0>(b);
+        return get<1>(a) > get<1>(b);
+    };
+    priority_queue<Head, vector<Head>, decltype(after)> heads(after);
+    for (int r = 0; r < (int)runs.size(); r++) {
+        if (!runs[r].empty()) heads.push(Head(runs[r][0].first, runs[r][0].second, r, 0));
+    }
+
+    vector<int> result;
+    unordered_set<int> emitted;
+    while (!heads.empty() && (int)result.size() < limit) {
+        Head top = heads.top();
+        heads.pop();
+        if (!distinctIDs || emitted.insert(get<1>(top)).second) {
+            result.push_back(get<1>(top));
+        }
+        int r = get<2>(top), next = get<3>(top) + 1;
+        if (next < (int)runs[r].size()) {
+            heads.push(Head(runs[r][next].first, runs[r][next].second, r, next));
         }
-        return -1;
     }
+    return result;
+}
+
+// Thread-safe Leaderboard that partitions players over independently
+// locked ConcreteLeaderboard shards, so updates to different shards run in
+// parallel. Reads gather each shard's ranking-ordered prefix under that
+// shard's lock and k-way merge them; shards are visited one at a time, so
+// a read is not an atomic snapshot across shards.
+class ShardedLeaderboard : public Leaderboard {
+private:
+    struct alignas(64) Shard {
+        mutex lock;
+        ConcreteLeaderboard board;
+    };
 
+    vector<unique_ptr<Shard>> shards;
+    unsigned int shardMask;  // shards.size() - 1, a power of two minus one
 
-public:
-    ConcretePlayerTable() {
-        currentSize = 0;
+    Shard& shardFor(int playerID) {
+        unsigned int h = (unsigned int)playerID * 2654435769u;
+        return *shards[(h >> 16) & shardMask];
     }
-    void insert(int playerID, string name) override {
-        // Check if table is full
-        if (currentSize >= TABLE_SIZE) {
-            throw "Table is full";
+
+public:
+    ShardedLeaderboard(int shardCount = 16) {
+        int count = 1;
+        while (count < shardCount) count *= 2;
+        for (int i = 0; i < count; i++) {
+            shards.emplace_back(new Shard());
         }
+        shardMask = (unsigned int)(count - 1);
+    }
 
-        int index = findIndex(playerID);
-        if (index == -1) {
-            throw "Table is full";
+    void addScore(int playerID, int score) override {
+        Shard& shard = shardFor(playerID);
+        lock_guard<mutex> guard(shard.lock);
+        shard.board.addScore(playerID, score);
+    }
+
+    void removePlayer(int playerID) override {
+        Shard& shard = shardFor(playerID);
+        lock_guard<mutex> guard(shard.lock);
+        shard.board.removePlayer(playerID);
+    }
+
+    vector<int> getTopN(int n) override {
+        if (n <= 0) return vector<int>();
+        vector<ScoreRun> runs(shards.size());
+        for (size_t i = 0; i < shards.size(); i++) {
+            lock_guard<mutex> guard(shards[i]->lock);
+            shards[i]->board.appendTopEntries(n, runs[i]);
         }
+        return mergeRuns(runs, n);
+    }
+
+    int getTopN(int n, int* out) override {
+        vector<int> top = getTopN(n);
+        copy(top.begin(), top.end(), out);
+        return (int)top.size();
+    }
 
-        // If inserting into empty slot (not update), increase size
-        if (!table[index].occupied) {
-            currentSize++;
+    // Own rank within the player's shard plus everyone ahead elsewhere
+    int getRank(int playerID) override {
+        Shard& home = shardFor(playerID);
+        int score, rank;
+        {
+            lock_guard<mutex> guard(home.lock);
+            if (!home.board.findScore(playerID, score)) return -1;
+            rank = home.board.getRank(playerID);
+        }
+        for (auto& shard : shards) {
+            if (shard.get() == &home) continue;
+            lock_guard<mutex> guard(shard->lock);
+            rank += shard->board.countBefore(score, playerID);
         }
+        return rank;
+    }
 
-        // Insert/update
-        table[index] = HashEntry(playerID, name);
+    int countInScoreRange(int minScore, int maxScore) override {
+        int total = 0;
+        for (auto& shard : shards) {
+            lock_guard<mutex> guard(shard->lock);
+            total += shard->board.countInScoreRange(minScore, maxScore);
+        }
+        return total;
     }
 
-    string search(int playerID) override {
-        int index = findExistingIndex(playerID);
-        if (index != -1) {
-            return table[index].name;
+    vector<int> getPlayersInScoreRange(int minScore, int maxScore) override {
+        vector<ScoreRun> runs(shards.size());
+        for (size_t i = 0; i < shards.size(); i++) {
+            lock_guard<mutex> guard(shards[i]->lock);
+            shards[i]->board.appendEntriesInScoreRange(minScore, maxScore, runs[i]);
         }
-        return "";
+        return mergeRuns(runs, INT_MAX);
     }
 };
 
-// --- 2. Leaderboard (Skip List) ---
-
-class ConcreteLeaderboard : public Leaderboard {
+// --- 2e. WindowedLeaderboard (Bucketed Time Windows) ---
+
+// Leaderboard over a sliding window of the last `bucketCount` buckets. The
+// caller starts a new bucket with rollover() at each boundary (e.g. hourly
+// buckets, 24 of them for a daily board); the oldest bucket then leaves
+// the window at a cost proportional to its own size, with no replay.
+//   WINDOW_BEST_SCORE: addScore submits a score; a player ranks by the best
+//     one in the window. Each bucket keeps its own board and getTopN
+//     merges the bucket heads, dropping repeated players.
+//   WINDOW_SUM_SCORES: addScore adds points; a player ranks by the window
+//     total, kept in an aggregate board that rollover corrects by
+//     subtracting only the expiring bucket's contributions.
+class WindowedLeaderboard : public Leaderboard {
 private:
-    struct Node {
-        int playerID, score;
-        vector<Node*> next;
-        Node(int id, int s, int level) : playerID(id), score(s), next(level + 1, nullptr) {}
+    struct Bucket {
+        unordered_map<int, long long> scores;   // Best score or summed points
+        unique_ptr<ConcreteLeaderboard> board;  // WINDOW_BEST_SCORE only
     };
 
-    Node* head;
-    const int MAX_LEVEL = 16;
-    int currentLevel;  // Track current max level in use
-    // Helper to compare two nodes based on requirements
-    // Primary: higher score comes first, Secondary: lower ID comes first for same score
-    bool shouldPlaceBefore(Node* a, Node* b) {
-        if (!b) return true; // NULL comes at the end
-        if (a->score > b->score) return true;
-        if (a->score == b->score && a->playerID < b->playerID) return true;
-        return false;
+    struct WindowTotal {
+        long long sum = 0;
+        int buckets = 0;  // Buckets in the window that hold the player
+    };
+
+    WindowPolicy policy;
+    int bucketCount;
+    deque<Bucket> buckets;  // back() receives new scores
+
+    // WINDOW_SUM_SCORES only
+    ConcreteLeaderboard totals;
+    unordered_map<int, WindowTotal> totalOf;
+
+    static int clampScore(long long score) {
+        return (int)max<long long>(INT_MIN, min<long long>(INT_MAX, score));
     }
-    int randomLevel() {
-        int level = 0;
-        while (rand() % 2 == 0 && level < MAX_LEVEL - 1) {
-            level++;
+
+    void openBucket() {
+        buckets.emplace_back();
+        if (policy == WINDOW_BEST_SCORE) buckets.back().board.reset(new ConcreteLeaderboard());
+    }
+
+public:
+    WindowedLeaderboard(int windowBuckets, WindowPolicy windowPolicy)
+        : policy(windowPolicy), bucketCount(windowBuckets) {
+        if (windowBuckets < 1) throw "Window needs at least one bucket";
+        openBucket();
+    }
+
+    void addScore(int playerID, int score) override {
+        Bucket& current = buckets.back();
+        auto it = current.scores.find(playerID);
+        if (policy == WINDOW_BEST_SCORE) {
+            if (it != current.scores.end() && it->second >= score) return;
+            current.scores[playerID] = score;
+            current.board->addScore(playerID, score);
+            return;
         }
-        return level;
+
+        if (it == current.scores.end()) {
+            current.scores[playerID] = score;
+            totalOf[playerID].buckets++;
+        }
+        else {
+            it->second += score;
+        }
+        WindowTotal& total = totalOf[playerID];
+        total.sum += score;
+        totals.addScore(playerID, clampScore(total.sum));
     }
-    // Linear scan to find node by ID 
-    Node* findNodeByID(int playerID) {
-        Node* current = head->next[0];
-        while (current) {
-            if (current->playerID == playerID) {
-                return current;
+
+    void removePlayer(int playerID) override {
+        for (Bucket& bucket : buckets) {
+            if (bucket.scores.erase(playerID) && bucket.board) {
+                bucket.board->removePlayer(playerID);
             }
-            current = current->next[0];
         }
-        return nullptr;
+        if (totalOf.erase(playerID)) totals.removePlayer(playerID);
     }
 
-public:
-    ConcreteLeaderboard() {
-        srand(time(0));
-        currentLevel = 0;
-        head = new Node(-1, INT_MIN, MAX_LEVEL);  // Dummy head with lowest possible score
+    void rollover() override {
+        openBucket();
+        if ((int)buckets.size() <= bucketCount) return;
+
+        if (policy == WINDOW_SUM_SCORES) {
+            for (const auto& entry : buckets.front().scores) {
+                auto it = totalOf.find(entry.first);
+                it->second.sum -= entry.second;
+                if (--it->second.buckets == 0) {
+                    totals.removePlayer(entry.first);
+                    totalOf.erase(it);
+                }
+                else {
+                    totals.addScore(entry.first, clampScore(it->second.sum));
+                }
+            }
+        }
+        buckets.pop_front();
     }
 
-    ~ConcreteLeaderboard() {
-        Node* curr = head->next[0];
-        while (curr) {
-            Node* next = curr->next[0];
-            delete curr;
-            curr = next;
+    vector<int> getTopN(int n) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getTopN(n);
+        if (n <= 0) return vector<int>();
+        // A player's best entry ranks no lower in its bucket than in the
+        // window, so each bucket's top n is enough
+        vector<ScoreRun> runs(buckets.size());
+        for (size_t i = 0; i < buckets.size(); i++) {
+            buckets[i].board->appendTopEntries(n, runs[i]);
         }
-        delete head;
+        return mergeRuns(runs, n, true);
     }
 
-    void addScore(int playerID, int score) override {
-        // Remove existing player first
-        removePlayer(playerID);
+    int getTopN(int n, int* out) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getTopN(n, out);
+        return Leaderboard::getTopN(n, out);
+    }
 
-        // Generate random level
-        int level = randomLevel();
+    int getRank(int playerID) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getRank(playerID);
+        return Leaderboard::getRank(playerID);
+    }
 
-        // Update current level if needed
-        if (level > currentLevel) {
-            for (int i = currentLevel + 1; i <= level; i++) {
-                head->next[i] = nullptr;
-            }
-            currentLevel = level;
-        }
+    int getByRank(int rank) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getByRank(rank);
+        return Leaderboard::getByRank(rank);
+    }
 
-        // Create new node
-        Node* newNode = new Node(playerID, score, level);
-        Node* curr = head;
+    vector<int> getPlayersAroundRank(int rank, int radius) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getPlayersAroundRank(rank, radius);
+        return Leaderboard::getPlayersAroundRank(rank, radius);
+    }
 
-        // Find insertion position and insert at each level
-        for (int i = currentLevel; i >= 0; i--) {
-            // CORRECTED: Proper tie-breaking
-            // Move while next node has HIGHER score OR same score with LOWER ID
-            while (curr->next[i] &&
-                (curr->next[i]->score > score ||
-                    (curr->next[i]->score == score && curr->next[i]->playerID < playerID))) {
-                curr = curr->next[i];
-            }
+    int countInScoreRange(int minScore, int maxScore) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.countInScoreRange(minScore, maxScore);
+        return Leaderboard::countInScoreRange(minScore, maxScore);
+    }
 
-            // Insert at this level
-            if (i <= level) {
-                newNode->next[i] = curr->next[i];
-                curr->next[i] = newNode;
-            }
-        }
+    vector<int> getPlayersInScoreRange(int minScore, int maxScore) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.getPlayersInScoreRange(minScore, maxScore);
+        return Leaderboard::getPlayersInScoreRange(minScore, maxScore);
     }
 
-    void removePlayer(int playerID) override {
-        // First find the node and its score (linear search at level 0)
-        Node* target = findNodeByID(playerID);
-        if (!target) return;  // Player not found
+    double percentile(int score) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.percentile(score);
+        return Leaderboard::percentile(score);
+    }
 
-        int targetScore = target->score;
+    int scoreAtPercentile(double pct) override {
+        if (policy == WINDOW_SUM_SCORES) return totals.scoreAtPercentile(pct);
+        return Leaderboard::scoreAtPercentile(pct);
+    }
+};
 
-        // Now use skip list search with score AND tie-breaking
-        vector<Node*> update(MAX_LEVEL + 1, nullptr);
-        Node* current = head;
+// --- 2f. FenwickLeaderboard (Score Buckets + Fenwick Tree) ---
 
-        // Find update nodes using the SAME comparison as insertion
-        for (int i = MAX_LEVEL; i >= 0; i--) {
-            // Use proper comparison: higher scores first, then lower IDs for same score
-            while (current->next[i] &&
-                (current->next[i]->score > targetScore ||
-                    (current->next[i]->score == targetScore &&
-                        current->next[i]->playerID < playerID))) {
-                current = current->next[i];
-            }
-            update[i] = current;
+// Leaderboard for integer scores in a known range [lowScore, highScore].
+// Each score owns a bucket of player IDs kept in ascending order, and a
+// Fenwick tree over the bucket sizes (best score first) turns rank and
+// position lookups into O(log S) prefix sums and descents, S being the
+// range size. Memory is a few flat arrays of size S, so the range should
+// be dense; a bucket insert shifts its own IDs, which stays cheap while
+// ties per score are modest.
+class FenwickLeaderboard : public Leaderboard {
+private:
+    int lowScore;
+    int highScore;
+    int slotCount;
+    int topStep;                  // Highest power of two <= slotCount
+    vector<vector<int>> buckets;  // Slot = highScore - score
+    vector<int> tree;             // 1-based Fenwick tree over bucket sizes
+    unordered_map<int, int> scoreOf;
+    int length = 0;
+
+    int slotOf(int score) const {
+        return highScore - score;
+    }
+
+    void checkScore(int score) const {
+        if (score < lowScore || score > highScore) throw "Score outside the board's range";
+    }
+
+    void adjust(int slot, int delta) {
+        for (int i = slot + 1; i <= slotCount; i += i & -i) {
+            tree[i] += delta;
         }
+        length += delta;
+    }
 
-        // At this point, current->next[0] should be our target OR 
-        // a node with same score but lower ID
+    // Players in slots [0, slot)
+    int countBefore(int slot) const {
+        int total = 0;
+        for (int i = slot; i > 0; i -= i & -i) {
+            total += tree[i];
+        }
+        return total;
+    }
 
-        // Check if we found the exact node
-        if (current->next[0] && current->next[0]->playerID == playerID) {
-            Node* toRemove = current->next[0];
+    // Slot holding `rank` (1..length); `rank` becomes the offset in it
+    int descend(int& rank) const {
+        int pos = 0;
+        for (int step = topStep; step > 0; step >>= 1) {
+            if (pos + step <= slotCount && tree[pos + step] < rank) {
+                pos += step;
+                rank -= tree[pos];
+            }
+        }
+        return pos;
+    }
 
-            // Remove from all levels
-            for (int i = 0; i <= MAX_LEVEL; i++) {
-                // The update[i] should already point to predecessor
-                // But we need to verify and possibly adjust
-                Node* pred = update[i];
+    void insertID(int slot, int playerID) {
+        vector<int>& bucket = buckets[slot];
+        bucket.insert(lower_bound(bucket.begin(), bucket.end(), playerID), playerID);
+        adjust(slot, 1);
+    }
 
-                // If pred->next[i] is not our target, we need to find it
-                while (pred->next[i] && pred->next[i] != toRemove) {
-                    pred = pred->next[i];
-                }
+    void eraseID(int slot, int playerID) {
+        vector<int>& bucket = buckets[slot];
+        bucket.erase(lower_bound(bucket.begin(), bucket.end(), playerID));
+        adjust(slot, -1);
+    }
 
-                // Now pred should point to node before target (or be target itself)
-                if (pred->next[i] == toRemove) {
-                    pred->next[i] = toRemove->next[i];
-                }
+    // Writes the IDs ranked first..first+count-1 (clipped) and returns how
+    // many were written. Short gaps between buckets are scanned, longer
+    // ones skipped with a descent, so sparse ranges cost O(log S) per
+    // bucket rather than O(S).
+    int collect(int first, int count, int* out) const {
+        const int SCAN_LIMIT = 8;
+        if (first < 1) {
+            count += first - 1;
+            first = 1;
+        }
+        count = min(count, length - first + 1);
+        if (count <= 0) return 0;
+
+        int offset = first;
+        int slot = descend(offset);
+        size_t i = offset - 1;
+        int written = 0;
+        while (true) {
+            const vector<int>& bucket = buckets[slot];
+            for (; i < bucket.size() && written < count; i++) {
+                out[written++] = bucket[i];
             }
+            if (written == count) return written;
+            int limit = min(slotCount, slot + 1 + SCAN_LIMIT);
+            for (slot++; slot < limit && buckets[slot].empty(); slot++) {}
+            if (slot == limit) {
+                offset = first + written;
+                slot = descend(offset);
+            }
+            i = 0;
+        }
+    }
 
-            delete toRemove;
+    vector<int> collect(int first, int count) const {
+        vector<int> result(max(0, min(count, length)));
+        result.resize(collect(first, (int)result.size(), result.data()));
+        return result;
+    }
 
-            // Update currentLevel
-            while (currentLevel > 0 && head->next[currentLevel] == nullptr) {
-                currentLevel--;
-            }
+public:
+    FenwickLeaderboard(int minScore, int maxScore) : lowScore(minScore), highScore(maxScore) {
+        if (minScore > maxScore || (long long)maxScore - minScore >= INT_MAX) {
+            throw "Invalid score range";
+        }
+        slotCount = maxScore - minScore + 1;
+        topStep = 1;
+        while (topStep <= slotCount / 2) topStep *= 2;
+        buckets.resize(slotCount);
+        tree.assign(slotCount + 1, 0);
+    }
+
+    void addScore(int playerID, int score) override {
+        checkScore(score);
+        auto it = scoreOf.find(playerID);
+        if (it != scoreOf.end()) {
+            if (it->second == score) return;
+            eraseID(slotOf(it->second), playerID);
+            it->second = score;
+        }
+        else {
+            scoreOf[playerID] = score;
         }
+        insertID(slotOf(score), playerID);
+    }
+
+    void removePlayer(int playerID) override {
+        auto it = scoreOf.find(playerID);
+        if (it == scoreOf.end()) return;
+        eraseID(slotOf(it->second), playerID);
+        scoreOf.erase(it);
     }
 
     vector<int> getTopN(int n) override {
-        vector<int> result;
-        Node* curr = head->next[0];
-        while (curr && result.size() < n) {
-            result.push_back(curr->playerID);
-            curr = curr->next[0];
+        return collect(1, n);
+    }
+
+    int getTopN(int n, int* out) override {
+        return collect(1, n, out);
+    }
+
+    int getRank(int playerID) override {
+        auto it = scoreOf.find(playerID);
+        if (it == scoreOf.end()) return -1;
+        int slot = slotOf(it->second);
+        const vector<int>& bucket = buckets[slot];
+        int offset = (int)(lower_bound(bucket.begin(), bucket.end(), playerID) - bucket.begin());
+        return countBefore(slot) + offset + 1;
+    }
+
+    int getByRank(int rank) override {
+        if (rank < 1 || rank > length) return -1;
+        int slot = descend(rank);
+        return buckets[slot][rank - 1];
+    }
+
+    vector<int> getPlayersAroundRank(int rank, int radius) override {
+        int first = max(1, rank - radius);
+        int last = rank + radius;
+        if (first > last) return vector<int>();
+        return collect(first, last - first + 1);
+    }
+
+    int countInScoreRange(int minScore, int maxScore) override {
+        minScore = max(minScore, lowScore);
+        maxScore = min(maxScore, highScore);
+        if (minScore > maxScore) return 0;
+        return countBefore(slotOf(minScore) + 1) - countBefore(slotOf(maxScore));
+    }
+
+    vector<int> getPlayersInScoreRange(int minScore, int maxScore) override {
+        int count = countInScoreRange(minScore, maxScore);
+        if (count == 0) return vector<int>();
+        return collect(countBefore(slotOf(min(maxScore, highScore))) + 1, count);
+    }
+
+    double percentile(int score) override {
+        if (length == 0) return 0.0;
+        if (score <= lowScore) return 0.0;
+        int below = score > highScore ? length : length - countBefore(slotOf(score) + 1);
+        return 100.0 * below / length;
+    }
+
+    int scoreAtPercentile(double pct) override {
+        if (length == 0) throw "Leaderboard is empty";
+        int rank = length - percentilePosition(pct, length) + 1;
+        return highScore - descend(rank);
+    }
+
+    // Validates everything first, then refills the buckets in slot order
+    // and builds the Fenwick tree in linear time
+    void bulkLoad(const vector<pair<int, int>>& entries) override {
+        for (const auto& entry : entries) {
+            checkScore(entry.second);
+        }
+        for (const auto& entry : entries) {
+            scoreOf[entry.first] = entry.second;
         }
+        vector<pair<int, int>> ranked;  // (slot, playerID)
+        ranked.reserve(scoreOf.size());
+        for (const auto& entry : scoreOf) {
+            ranked.push_back({ slotOf(entry.second), entry.first });
+        }
+        sort(ranked.begin(), ranked.end());
 
-        return result;
+        for (vector<int>& bucket : buckets) {
+            bucket.clear();
+        }
+        for (const auto& entry : ranked) {
+            buckets[entry.first].push_back(entry.second);
+        }
+        for (int i = 1; i <= slotCount; i++) {
+            tree[i] = (int)buckets[i - 1].size();
+        }
+        for (int i = 1; i <= slotCount; i++) {
+            int parent = i + (i & -i);
+            if (parent <= slotCount) tree[parent] += tree[i];
+        }
+        length = (int)ranked.size();
     }
 };
+
 // --- 3. AuctionTree (Red-Black Tree) ---
 
 class ConcreteAuctionTree : public AuctionTree {
@@ -299,6 +3715,10 @@ private:
 
     Node* root;
     Node* nil;
+    // The tree is keyed by (price, itemID); this finds a node from its
+    // itemID alone. Rotations and rbDelete relink nodes without moving
+    // keys, so entries stay valid until the node is freed.
+    unordered_map<int, Node*> nodeOf;
 
     // ========== BASIC ROTATIONS ==========
     void leftRotate(Node* x) {
@@ -444,6 +3864,7 @@ private:
         z->left = nil;
         z->right = nil;
         z->color = RED;
+        nodeOf[z->itemID] = z;
 
         insertFixup(z);
     }
@@ -474,18 +3895,8 @@ private:
 
     // Helper: Find node by itemID
     Node* findNode(int itemID) {
-        return findHelper(root, itemID);
-    }
-
-    Node* findHelper(Node* node, int itemID) {
-        if (node == nil) return nil;
-
-        if (node->itemID == itemID) return node;
-
-        Node* leftResult = findHelper(node->left, itemID);
-        if (leftResult != nil) return leftResult;
-
-        return findHelper(node->right, itemID);
+        auto it = nodeOf.find(itemID);
+        return it == nodeOf.end() ? nil : it->second;
     }
 
     // MAIN DELETE FIXUP FUNCTION - Handles all 8 cases
@@ -603,6 +4014,7 @@ private:
             deleteFixup(x);
         }
 
+        nodeOf.erase(z->itemID);
         delete z;
     }
 
@@ -628,7 +4040,9 @@ public:
     }
 
     void insertItem(int itemID, int price) override {
-        // Check if item exists
+        // Check if item exists; relisting at the same price is a no-op
+        Node* existing = findNode(itemID);
+        if (existing != nil && existing->price == price) return;
         deleteItem(itemID);
         Node* newNode = new Node(itemID, price);
         bstInsert(newNode);
@@ -893,15 +4307,85 @@ int ServerKernel::minIntervals(vector<char>& tasks, int n) {
 //FACTORY FUNCTIONS (Required for Testing)
 //=========================================================
 
+// Several factories throw const char* on bad arguments or files. MSVC's
+// default /EHsc assumes extern "C" functions never throw, so the project
+// builds with /EHs (ExceptionHandling = SyncCThrow) to keep those throws
+// catchable.
 extern "C" {
     PlayerTable* createPlayerTable() {
         return new ConcretePlayerTable();
     }
 
+    PlayerTable* createResizablePlayerTable() {
+        return new ConcretePlayerTable(true);
+    }
+
+    PlayerTable* createIndexedPlayerTable() {
+        return new ConcretePlayerTable(true, 101, true);
+    }
+
+    PlayerTable* createFlatPlayerTable() {
+        return new FlatPlayerTable();
+    }
+
+    PlayerTable* createShardedPlayerTable(int shardCount) {
+        return new ShardedPlayerTable(shardCount);
+    }
+
+    PlayerTable* loadPlayerTableSnapshot(const char* path) {
+        return new MappedPlayerTable(path);
+    }
+
+    // Drop-in for createPlayerTable: 101 slots, constant-divisor hashing
+    PlayerTable* createPrimePlayerTable() {
+        return new StaticPlayerTable<101, PrimeModuloHash>();
+    }
+
+    PlayerTable* createLargePrimePlayerTable() {
+        return new StaticPlayerTable<2097143, PrimeModuloHash>();
+    }
+
+    PlayerTable* createFibonacciPlayerTable() {
+        return new StaticPlayerTable<(1 << 21), FibonacciHash>();
+    }
+
     Leaderboard* createLeaderboard() {
         return new ConcreteLeaderboard();
     }
 
+    // Promotion probability p in (0, 1) and a fixed level seed, for
+    // reproducible layouts
+    Leaderboard* createLeaderboardWithConfig(double p, unsigned long long seed) {
+        return new ConcreteLeaderboard(p, seed);
+    }
+
+    Leaderboard* createConcurrentLeaderboard() {
+        return new ConcurrentLeaderboard();
+    }
+
+    // additive: addScore adds to the current score instead of replacing it
+    Leaderboard* createBufferedLeaderboard(bool additive) {
+        return new BufferedLeaderboard(additive);
+    }
+
+    Leaderboard* createShardedLeaderboard(int shardCount) {
+        return new ShardedLeaderboard(shardCount);
+    }
+
+    Leaderboard* createWindowedLeaderboard(int bucketCount, WindowPolicy policy) {
+        return new WindowedLeaderboard(bucketCount, policy);
+    }
+
+    // Integer scores limited to [minScore, maxScore]; addScore throws
+    // outside it
+    Leaderboard* createFenwickLeaderboard(int minScore, int maxScore) {
+        return new FenwickLeaderboard(minScore, maxScore);
+    }
+
+    Leaderboard* loadLeaderboardSnapshot(const char* path) {
+        return ConcreteLeaderboard::loadSnapshot(path);
+    }
+
     AuctionTree* createAuctionTree() {
         return new ConcreteAuctionTree();
     }
@@ -4,28 +4,167 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 using namespace std;
 
 // PART A: DATA STRUCTURES
+
+// Occupancy and probe behavior of a PlayerTable. Probe counters are only
+// maintained when the engine is compiled with ARCADIA_TABLE_STATS=1 (default).
+struct PlayerTableStats {
+    int size = 0;
+    int capacity = 0;
+    double loadFactor = 0.0;
+    double tombstoneRatio = 0.0;
+    // Times the table was rebuilt at its current capacity to drop tombstones
+    long long rebuilds = 0;
+
+    long long insertOps = 0;
+    double avgInsertProbes = 0.0;
+    int maxInsertProbes = 0;
+    long long searchOps = 0;
+    double avgSearchProbes = 0.0;
+    int maxSearchProbes = 0;
+    // [k] = inserts and searches that took k+1 probes; last bucket is open-ended
+    vector<long long> probeHistogram;
+
+    // [k] = runs of k+1 consecutive non-empty slots; last bucket is open-ended
+    vector<long long> clusterHistogram;
+    int maxClusterSize = 0;
+
+    // Bytes held by the name arena: live names plus released bytes not yet
+    // compacted away
+    long long nameArenaBytes = 0;
+};
+
 class PlayerTable {
 public:
+    virtual ~PlayerTable() {}
+
     // Use Double Hashing logic
-    virtual void insert(int playerID, string name) = 0; 
+    virtual void insert(int playerID, const string& name) = 0;
     virtual string search(int playerID) = 0;
+
+    // Deletes the player if present, leaving a tombstone in its slot
+    virtual void remove(int playerID) = 0;
+
+    // Fraction of slots currently holding tombstones
+    virtual double tombstoneRatio();
+
+    // Binary snapshot that loadPlayerTableSnapshot() can map back in
+    virtual void saveSnapshot(const string& path);
+
+    virtual PlayerTableStats stats();
+
+    // IDs (ascending) of every player stored under exactly this name.
+    // Only engines built with a name index support it.
+    virtual vector<int> searchByName(const string& name);
+
+    // Session expiry on a logical clock driven by advanceTime: the entry is
+    // removed once the clock has moved `ttl` ticks past its (re)insertion.
+    // A plain insert() of the same ID keeps its current expiry.
+    virtual void insertWithTTL(int playerID, const string& name, long long ttl);
+    virtual void advanceTime(long long ticks);
+
+    // Allocation-free lookup; empty view if not found. The view points into
+    // the table's name storage and is valid until the next mutation of the
+    // table (insert, remove, TTL insert, snapshot).
+    virtual string_view searchView(int playerID) = 0;
+
+    // Batched variants that overlap memory latency across keys;
+    // results[i] is the searchView of playerIDs[i]
+    virtual void insertBatch(const vector<pair<int, string>>& entries);
+    virtual void searchBatch(const vector<int>& playerIDs, vector<string_view>& results);
+};
+
+// How a windowed leaderboard combines a player's scores across buckets
+enum WindowPolicy {
+    WINDOW_BEST_SCORE,  // Best single score in the window
+    WINDOW_SUM_SCORES   // Sum of all points earned in the window
+};
+
+// Change to a Leaderboard's top K, in ranks 1..K (0 = outside the top K).
+// Applying events in order to a list (LEFT: erase at oldRank, ENTERED:
+// insert at newRank, MOVED: both) reproduces getTopN(K) exactly.
+enum RankEventKind {
+    RANK_ENTERED,
+    RANK_LEFT,
+    RANK_MOVED,
+    RANK_RESYNC  // Clear the list; the current top K follows as ENTERED events
+};
+
+struct RankEvent {
+    RankEventKind kind;
+    int playerID;
+    int oldRank;
+    int newRank;
 };
 
 class Leaderboard {
 public:
+    virtual ~Leaderboard() {}
+
     // Skip List Implementation
     virtual void addScore(int playerID, int score) = 0;
     virtual void removePlayer(int playerID) = 0;
     virtual vector<int> getTopN(int n) = 0; // Return IDs of top N
+
+    // Allocation-free variant: writes up to n IDs to `out` (room for n)
+    // and returns how many were written
+    virtual int getTopN(int n, int* out);
+
+    // Ranks are 1-based in getTopN order. getRank returns -1 for an unknown
+    // player and getByRank returns -1 for a rank outside [1, size].
+    virtual int getRank(int playerID);
+    virtual int getByRank(int rank);
+
+    // IDs ranked in [rank - radius, rank + radius], clipped to the board;
+    // pair with getRank to show the players around someone
+    virtual vector<int> getPlayersAroundRank(int rank, int radius);
+
+    // Players with minScore <= score <= maxScore, IDs in ranking order
+    virtual int countInScoreRange(int minScore, int maxScore);
+    virtual vector<int> getPlayersInScoreRange(int minScore, int maxScore);
+
+    // Score distribution, answered from the same counts as the range
+    // queries. percentile: share of players (0..100) scoring below `score`.
+    // scoreAtPercentile: nearest-rank score, the lowest one that at least
+    // pct% of players score at or under; throws on an empty board.
+    // Histogram bucket i counts scores in
+    // [minScore + i * bucketWidth, minScore + (i + 1) * bucketWidth).
+    virtual double percentile(int score);
+    virtual int scoreAtPercentile(double pct);
+    virtual vector<int> getScoreHistogram(int minScore, int bucketWidth, int bucketCount);
+
+    // Applies updates a buffering board is still holding; reads flush
+    // implicitly. No-op for boards that write through.
+    virtual void flush();
+
+    // Windowed boards: closes the current time bucket and starts a new one,
+    // expiring the oldest bucket once the window is full
+    virtual void rollover();
+
+    // Applies (playerID, score) pairs as if by addScore in order; boards
+    // with a bulk path sort once and rebuild instead of inserting per pair
+    virtual void bulkLoad(const vector<pair<int, int>>& entries);
+
+    // Binary snapshot that loadLeaderboardSnapshot() can restore
+    virtual void saveSnapshot(const string& path);
+
+    // Starts a top-K rank change feed buffered in a lock-free ring of about
+    // `capacity` events; it opens with a RESYNC. One thread may poll while
+    // another writes. When the ring overflows, events are dropped and a
+    // RESYNC is sent with a later write once the poller has made room.
+    virtual void watchTopK(int k, int capacity);
+    virtual int pollRankEvents(RankEvent* out, int maxEvents);
 };
 
 class AuctionTree {
 public:
+    virtual ~AuctionTree() {}
+
     // Red-Black Tree Implementation
     virtual void insertItem(int itemID, int price) = 0;
     virtual void deleteItem(int itemID) = 0;
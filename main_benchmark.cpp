@@ -0,0 +1,685 @@
+/**
+ * main_benchmark.cpp
+ * Throughput benchmarks for the ArcadiaEngine data structures.
+ * Build separately from the test suite, with optimizations on, e.g.
+ *   g++ -std=c++17 -O2 -pthread ArcadiaEngine.cpp main_benchmark.cpp -o bench
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <unordered_map>
+#include <climits>
+#include "ArcadiaEngine.h"
+
+using namespace std;
+
+// ==========================================
+// FACTORY FUNCTIONS (LINKING)
+// ==========================================
+extern "C" {
+    PlayerTable* createResizablePlayerTable();
+    PlayerTable* createFlatPlayerTable();
+    PlayerTable* createShardedPlayerTable(int shardCount);
+    PlayerTable* loadPlayerTableSnapshot(const char* path);
+    PlayerTable* createLargePrimePlayerTable();
+    PlayerTable* createFibonacciPlayerTable();
+    Leaderboard* createLeaderboardWithConfig(double p, unsigned long long seed);
+    Leaderboard* createConcurrentLeaderboard();
+    Leaderboard* createBufferedLeaderboard(bool additive);
+    Leaderboard* createShardedLeaderboard(int shardCount);
+    Leaderboard* createWindowedLeaderboard(int bucketCount, WindowPolicy policy);
+    Leaderboard* createFenwickLeaderboard(int minScore, int maxScore);
+    Leaderboard* loadLeaderboardSnapshot(const char* path);
+    AuctionTree* createAuctionTree();
+}
+
+// ==========================================
+// BENCHMARK UTILITIES
+// ==========================================
+class BenchmarkRunner {
+public:
+    // Runs body once and reports throughput for `ops` operations
+    void run(string name, long long ops, function<void()> body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        auto end = chrono::steady_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        cout << "BENCH: " << left << setw(50) << name
+             << right << setw(10) << fixed << setprecision(1) << (seconds * 1000.0) << " ms"
+             << setw(12) << setprecision(2) << (ops / seconds / 1e6) << " Mops/s" << endl;
+    }
+};
+
+BenchmarkRunner bench;
+
+// Keeps results observable so the optimizer cannot drop the work
+volatile size_t sink = 0;
+
+// ==========================================
+// PART A: DATA STRUCTURES
+// ==========================================
+
+void bench_PlayerTable_Batch() {
+    cout << "\n⏱ PLAYER TABLE - PER-KEY vs BATCHED SEARCH\n";
+
+    // 2M players: the slot arrays are far larger than L2
+    const int players = 2000000;
+    const int lookups = 2000000;
+    const int batchSize = 256;
+
+    mt19937 rng(42);
+    vector<int> ids(lookups);
+    for (int i = 0; i < lookups; i++) {
+        ids[i] = (int)(rng() % players) * 3;
+    }
+
+    PlayerTable* tables[] = { createResizablePlayerTable(), createFlatPlayerTable() };
+    const char* labels[] = { "Resizable", "Flat" };
+
+    for (int t = 0; t < 2; t++) {
+        PlayerTable* table = tables[t];
+        string label = labels[t];
+
+        vector<pair<int, string>> entries;
+        entries.reserve(players);
+        for (int i = 0; i < players; i++) {
+            entries.push_back({ i * 3, "Player" + to_string(i) });
+        }
+        bench.run(label + ": insertBatch 2M", players, [&]() {
+            table->insertBatch(entries);
+        });
+        // Finish any in-flight migration so both paths see the same layout
+        for (int i = 0; i < players; i++) table->searchView(i * 3);
+
+        bench.run(label + ": searchView x2M", lookups, [&]() {
+            size_t total = 0;
+            for (int id : ids) total += table->searchView(id).size();
+            sink = total;
+        });
+
+        bench.run(label + ": searchBatch(256) x2M", lookups, [&]() {
+            size_t total = 0;
+            vector<int> batch(batchSize);
+            vector<string_view> results;
+            for (int i = 0; i + batchSize <= lookups; i += batchSize) {
+                copy(ids.begin() + i, ids.begin() + i + batchSize, batch.begin());
+                table->searchBatch(batch, results);
+                for (string_view r : results) total += r.size();
+            }
+            sink = total;
+        });
+
+        delete table;
+    }
+}
+
+// Serializes every call behind one mutex, the way callers had to share a
+// single-threaded table before the sharded engine existed
+class GlobalLockPlayerTable : public PlayerTable {
+    PlayerTable* inner;
+    mutex lock;
+
+public:
+    GlobalLockPlayerTable(PlayerTable* table) : inner(table) {}
+    ~GlobalLockPlayerTable() { delete inner; }
+
+    void insert(int playerID, const string& name) override {
+        lock_guard<mutex> guard(lock);
+        inner->insert(playerID, name);
+    }
+    void remove(int playerID) override {
+        lock_guard<mutex> guard(lock);
+        inner->remove(playerID);
+    }
+    string search(int playerID) override {
+        lock_guard<mutex> guard(lock);
+        return inner->search(playerID);
+    }
+    string_view searchView(int playerID) override {
+        lock_guard<mutex> guard(lock);
+        return inner->searchView(playerID);
+    }
+};
+
+// Aggregate throughput of `threads` workers doing 95% search / 5% insert
+void runMixedWorkload(const string& label, PlayerTable* table, int players, int threads) {
+    const int opsPerThread = 500000;
+    bench.run(label + " x" + to_string(threads) + " threads", (long long)opsPerThread * threads, [&]() {
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                mt19937 rng(t + 1);
+                size_t total = 0;
+                for (int i = 0; i < opsPerThread; i++) {
+                    int id = (int)(rng() % players);
+                    if (i % 20 == 0) {
+                        table->insert(id, "Player" + to_string(id));
+                    }
+                    else {
+                        total += table->search(id).size();
+                    }
+                }
+                sink = total;
+            });
+        }
+        for (auto& w : workers) w.join();
+    });
+}
+
+void bench_PlayerTable_Concurrent() {
+    cout << "\n⏱ PLAYER TABLE - MULTI-THREADED MIXED WORKLOAD (95% read)\n";
+
+    const int players = 1000000;
+    int maxThreads = max(4, (int)thread::hardware_concurrency());
+
+    PlayerTable* global = new GlobalLockPlayerTable(createResizablePlayerTable());
+    PlayerTable* sharded = createShardedPlayerTable(64);
+    for (int i = 0; i < players; i++) {
+        global->insert(i, "Player" + to_string(i));
+        sharded->insert(i, "Player" + to_string(i));
+    }
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        runMixedWorkload("Global mutex", global, players, threads);
+        runMixedWorkload("Sharded(64)", sharded, players, threads);
+    }
+
+    delete global;
+    delete sharded;
+}
+
+void bench_PlayerTable_WarmStart() {
+    cout << "\n⏱ PLAYER TABLE - WARM START (re-insert vs mapped snapshot)\n";
+
+    const int players = 2000000;
+    const char* path = "arcadia_bench_snapshot.bin";
+
+    vector<pair<int, string>> entries;
+    entries.reserve(players);
+    for (int i = 0; i < players; i++) {
+        entries.push_back({ i * 3, "Player" + to_string(i) });
+    }
+
+    PlayerTable* rebuilt = createResizablePlayerTable();
+    bench.run("Rebuild by insert 2M", players, [&]() {
+        for (const auto& e : entries) rebuilt->insert(e.first, e.second);
+    });
+    rebuilt->saveSnapshot(path);
+    delete rebuilt;
+
+    PlayerTable* mapped = nullptr;
+    bench.run("Map snapshot + first 100k searches", 100000, [&]() {
+        mapped = loadPlayerTableSnapshot(path);
+        size_t total = 0;
+        for (int i = 0; i < 100000; i++) total += mapped->searchView(i * 3).size();
+        sink = total;
+    });
+    bench.run("Promote on first insert (2M copy)", players, [&]() {
+        mapped->insert(1, "First write");
+    });
+
+    delete mapped;
+    remove(path);
+}
+
+void bench_PlayerTable_HashPolicies() {
+    cout << "\n⏱ PLAYER TABLE - RUNTIME vs COMPILE-TIME HASHING (1M players, 2M-slot tables)\n";
+
+    const int players = 1000000;
+    const int lookups = 4000000;
+
+    mt19937 rng(7);
+    vector<int> keys(players);
+    for (int i = 0; i < players; i++) keys[i] = (int)rng();
+    vector<int> queries(lookups);
+    for (int i = 0; i < lookups; i++) {
+        // Half hits, half (almost certainly) misses
+        queries[i] = (i % 2 == 0) ? keys[rng() % players] : (int)rng();
+    }
+
+    PlayerTable* tables[] = { createResizablePlayerTable(), createLargePrimePlayerTable(), createFibonacciPlayerTable() };
+    const char* labels[] = { "Runtime %", "Prime<2097143>", "Fibonacci<2^21>" };
+
+    for (int t = 0; t < 3; t++) {
+        PlayerTable* table = tables[t];
+        string label = labels[t];
+        bench.run(label + ": insert 1M", players, [&]() {
+            for (int key : keys) table->insert(key, "P");
+        });
+        bench.run(label + ": searchView x4M", lookups, [&]() {
+            size_t total = 0;
+            for (int id : queries) total += table->searchView(id).size();
+            sink = total;
+        });
+        PlayerTableStats s = table->stats();
+        cout << "       load " << setprecision(2) << s.loadFactor
+             << ", avg search probes " << s.avgSearchProbes << endl;
+        delete table;
+    }
+}
+
+// Same seeded workload for each configuration, so runs are comparable
+void runLeaderboardUpdates(const string& label, Leaderboard* board) {
+    const int players = 1000000;
+    const int updates = 1000000;
+
+    mt19937 rng(99);
+    bench.run(label + ": insert 1M players", players, [&]() {
+        for (int i = 0; i < players; i++) board->addScore(i, (int)(rng() % 1000000));
+    });
+    bench.run(label + ": 1M updates of existing players", updates, [&]() {
+        for (int i = 0; i < updates; i++) board->addScore((int)(rng() % players), (int)(rng() % 1000000));
+    });
+    bench.run(label + ": removePlayer 100k", 100000, [&]() {
+        for (int i = 0; i < 100000; i++) board->removePlayer((int)(rng() % players));
+    });
+    bench.run(label + ": getRank x1M", 1000000, [&]() {
+        long long total = 0;
+        for (int i = 0; i < 1000000; i++) total += board->getRank((int)(rng() % players));
+        sink = (size_t)total;
+    });
+    bench.run(label + ": getPlayersAroundRank(r, 5) x1M", 1000000, [&]() {
+        size_t total = 0;
+        for (int i = 0; i < 1000000; i++) total += board->getPlayersAroundRank((int)(rng() % players) + 1, 5).size();
+        sink = total;
+    });
+    bench.run(label + ": countInScoreRange x1M", 1000000, [&]() {
+        long long total = 0;
+        for (int i = 0; i < 1000000; i++) {
+            int lo = (int)(rng() % 1000000);
+            total += board->countInScoreRange(lo, lo + 10000);
+        }
+        sink = (size_t)total;
+    });
+    delete board;
+}
+
+void bench_Leaderboard_Updates() {
+    cout << "\n⏱ LEADERBOARD - SCORE UPDATES ON A 1M-PLAYER BOARD\n";
+
+    runLeaderboardUpdates("p=1/2", createLeaderboardWithConfig(0.5, 99));
+    runLeaderboardUpdates("p=1/4", createLeaderboardWithConfig(0.25, 99));
+}
+
+// Single-threaded skip list behind one mutex, the baseline the concurrent
+// board replaces
+class GlobalLockLeaderboard : public Leaderboard {
+    Leaderboard* inner;
+    mutex lock;
+
+public:
+    GlobalLockLeaderboard(Leaderboard* board) : inner(board) {}
+    ~GlobalLockLeaderboard() { delete inner; }
+
+    using Leaderboard::getTopN;
+
+    void addScore(int playerID, int score) override {
+        lock_guard<mutex> guard(lock);
+        inner->addScore(playerID, score);
+    }
+    void removePlayer(int playerID) override {
+        lock_guard<mutex> guard(lock);
+        inner->removePlayer(playerID);
+    }
+    vector<int> getTopN(int n) override {
+        lock_guard<mutex> guard(lock);
+        return inner->getTopN(n);
+    }
+};
+
+// Aggregate throughput of `threads` workers doing 90% addScore / 10% getTopN(10)
+void runMixedLeaderboard(const string& label, Leaderboard* board, int players, int threads) {
+    const int opsPerThread = 200000;
+    bench.run(label + " x" + to_string(threads) + " threads", (long long)opsPerThread * threads, [&]() {
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                mt19937 rng(t + 1);
+                size_t total = 0;
+                for (int i = 0; i < opsPerThread; i++) {
+                    if (i % 10 == 0) {
+                        total += board->getTopN(10).size();
+                    }
+                    else {
+                        board->addScore((int)(rng() % players), (int)(rng() % 1000000));
+                    }
+                }
+                sink = total;
+            });
+        }
+        for (auto& w : workers) w.join();
+    });
+}
+
+void bench_Leaderboard_Concurrent() {
+    cout << "\n⏱ LEADERBOARD - MULTI-THREADED MIXED WORKLOAD (90% update, 10% top-10)\n";
+
+    const int players = 200000;
+    int maxThreads = max(4, (int)thread::hardware_concurrency());
+
+    Leaderboard* global = new GlobalLockLeaderboard(createLeaderboardWithConfig(0.5, 1));
+    Leaderboard* concurrent = createConcurrentLeaderboard();
+    Leaderboard* sharded = createShardedLeaderboard(16);
+    mt19937 rng(3);
+    for (int i = 0; i < players; i++) {
+        int score = (int)(rng() % 1000000);
+        global->addScore(i, score);
+        concurrent->addScore(i, score);
+        sharded->addScore(i, score);
+    }
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        runMixedLeaderboard("Global mutex", global, players, threads);
+        runMixedLeaderboard("Lazy skip list", concurrent, players, threads);
+        runMixedLeaderboard("Sharded(16) + merge", sharded, players, threads);
+    }
+
+    delete global;
+    delete concurrent;
+    delete sharded;
+}
+
+void bench_Leaderboard_HotUpdates() {
+    cout << "\n⏱ LEADERBOARD - HOT-PLAYER UPDATES (100k board, 1k hot players, top-10 every 10k)\n";
+
+    const int players = 100000;
+    const int hotPlayers = 1000;
+    const int updates = 2000000;
+
+    Leaderboard* boards[] = { createLeaderboardWithConfig(0.5, 5), createBufferedLeaderboard(false) };
+    const char* labels[] = { "Write-through", "Buffered" };
+
+    for (int b = 0; b < 2; b++) {
+        Leaderboard* board = boards[b];
+        mt19937 rng(17);
+        for (int i = 0; i < players; i++) board->addScore(i, (int)(rng() % 1000000));
+        board->flush();
+
+        bench.run(string(labels[b]) + ": 2M updates", updates, [&]() {
+            size_t total = 0;
+            for (int i = 0; i < updates; i++) {
+                board->addScore((int)(rng() % hotPlayers), (int)(rng() % 1000000));
+                if (i % 10000 == 0) total += board->getTopN(10).size();
+            }
+            sink = total;
+        });
+        delete board;
+    }
+}
+
+void bench_Leaderboard_TopN() {
+    cout << "\n⏱ LEADERBOARD - FRONT-PAGE getTopN(100) ON A 1M-PLAYER BOARD\n";
+
+    const int players = 1000000;
+    const int reads = 1000000;
+
+    Leaderboard* board = createLeaderboardWithConfig(0.5, 21);
+    mt19937 rng(21);
+    for (int i = 0; i < players; i++) board->addScore(i, (int)(rng() % 1000000));
+
+    bench.run("getTopN(100) -> vector x1M", reads, [&]() {
+        size_t total = 0;
+        for (int i = 0; i < reads; i++) total += board->getTopN(100).size();
+        sink = total;
+    });
+    bench.run("getTopN(100, out) x1M", reads, [&]() {
+        size_t total = 0;
+        int out[100];
+        for (int i = 0; i < reads; i++) total += board->getTopN(100, out);
+        sink = total;
+    });
+    bench.run("getTopN(100, out) + 1 update per 10 reads", reads, [&]() {
+        size_t total = 0;
+        int out[100];
+        for (int i = 0; i < reads; i++) {
+            if (i % 10 == 0) board->addScore((int)(rng() % players), (int)(rng() % 1000000));
+            total += board->getTopN(100, out);
+        }
+        sink = total;
+    });
+    delete board;
+}
+
+void bench_Leaderboard_Windowed() {
+    cout << "\n⏱ LEADERBOARD - DAILY WINDOW OF 24 HOURLY BUCKETS (20k events/hour, 48 hours)\n";
+
+    const int hours = 48;
+    const int window = 24;
+    const int eventsPerHour = 20000;
+    const int players = 100000;
+
+    mt19937 rng(48);
+    vector<vector<pair<int, int>>> events(hours);
+    for (auto& hour : events) {
+        for (int i = 0; i < eventsPerHour; i++) hour.push_back({ (int)(rng() % players), (int)(rng() % 1000) });
+    }
+
+    // Baseline: rebuild a fresh board from the window's events every hour
+    bench.run("Replay window into a new board each hour", (long long)hours * eventsPerHour, [&]() {
+        size_t total = 0;
+        for (int h = 0; h < hours; h++) {
+            unordered_map<int, int> sums;
+            for (int k = max(0, h - window + 1); k <= h; k++) {
+                for (const auto& e : events[k]) sums[e.first] += e.second;
+            }
+            Leaderboard* board = createLeaderboardWithConfig(0.5, 48);
+            for (const auto& entry : sums) board->addScore(entry.first, entry.second);
+            total += board->getTopN(10).size();
+            delete board;
+        }
+        sink = total;
+    });
+
+    Leaderboard* board = createWindowedLeaderboard(window, WINDOW_SUM_SCORES);
+    bench.run("Windowed(sum): ingest + hourly rollover", (long long)hours * eventsPerHour, [&]() {
+        size_t total = 0;
+        for (int h = 0; h < hours; h++) {
+            for (const auto& e : events[h]) board->addScore(e.first, e.second);
+            total += board->getTopN(10).size();
+            board->rollover();
+        }
+        sink = total;
+    });
+    delete board;
+
+    board = createWindowedLeaderboard(window, WINDOW_BEST_SCORE);
+    bench.run("Windowed(best): ingest + hourly rollover", (long long)hours * eventsPerHour, [&]() {
+        size_t total = 0;
+        for (int h = 0; h < hours; h++) {
+            for (const auto& e : events[h]) board->addScore(e.first, e.second);
+            total += board->getTopN(10).size();
+            board->rollover();
+        }
+        sink = total;
+    });
+    delete board;
+}
+
+void bench_Leaderboard_WarmStart() {
+    cout << "\n⏱ LEADERBOARD - WARM START OF A 2M-PLAYER BOARD\n";
+
+    const int players = 2000000;
+    const char* path = "arcadia_bench_leaderboard.bin";
+
+    mt19937 rng(2);
+    vector<pair<int, int>> entries(players);
+    for (int i = 0; i < players; i++) entries[i] = { i, (int)(rng() % 10000000) };
+
+    Leaderboard* inserted = createLeaderboardWithConfig(0.5, 2);
+    bench.run("addScore x2M", players, [&]() {
+        for (const auto& e : entries) inserted->addScore(e.first, e.second);
+    });
+    delete inserted;
+
+    Leaderboard* bulk = createLeaderboardWithConfig(0.5, 2);
+    bench.run("bulkLoad 2M (sort + linear build)", players, [&]() {
+        bulk->bulkLoad(entries);
+    });
+    bench.run("getRank x1M on the bulk-built board", 1000000, [&]() {
+        long long total = 0;
+        for (int i = 0; i < 1000000; i++) total += bulk->getRank((int)(rng() % players));
+        sink = (size_t)total;
+    });
+    bench.run("saveSnapshot 2M", players, [&]() {
+        bulk->saveSnapshot(path);
+    });
+    delete bulk;
+
+    Leaderboard* restored = nullptr;
+    bench.run("loadLeaderboardSnapshot 2M", players, [&]() {
+        restored = loadLeaderboardSnapshot(path);
+    });
+    sink = restored->getTopN(10).size();
+    delete restored;
+    remove(path);
+}
+
+void bench_Leaderboard_RankEvents() {
+    cout << "\n⏱ LEADERBOARD - TOP-100 CHANGE TRACKING ON A 1M BOARD\n";
+
+    const int players = 1000000;
+    const int updates = 1000000;
+    const int K = 100;
+    const int pollEvery = 64;
+
+    mt19937 rng(5);
+    vector<pair<int, int>> entries(players);
+    for (int i = 0; i < players; i++) entries[i] = { i, (int)(rng() % 10000000) };
+    vector<pair<int, int>> ops(updates);
+    for (int i = 0; i < updates; i++) ops[i] = { (int)(rng() % players), (int)(rng() % 10000000) };
+
+    auto runUpdates = [&](const char* label, int mode) {
+        Leaderboard* board = createLeaderboardWithConfig(0.5, 5);
+        board->bulkLoad(entries);
+        if (mode == 1) board->watchTopK(K, 4096);
+        vector<RankEvent> events(4096);
+        vector<int> previous = board->getTopN(K);
+        vector<int> current(K);
+        size_t changes = 0;
+        bench.run(label, updates, [&]() {
+            for (int i = 0; i < updates; i++) {
+                board->addScore(ops[i].first, ops[i].second);
+                if (i % pollEvery != pollEvery - 1) continue;
+                if (mode == 1) {
+                    changes += board->pollRankEvents(events.data(), (int)events.size());
+                }
+                else if (mode == 2) {
+                    int count = board->getTopN(K, current.data());
+                    for (int r = 0; r < count; r++) changes += current[r] != previous[r];
+                    previous.swap(current);
+                }
+            }
+        });
+        sink = changes;
+        delete board;
+    };
+
+    runUpdates("addScore x1M, no tracking", 0);
+    runUpdates("addScore x1M, event feed drained every 64", 1);
+    runUpdates("addScore x1M, getTopN(100) diff every 64", 2);
+}
+
+void bench_Leaderboard_Fenwick() {
+    cout << "\n⏱ LEADERBOARD - FENWICK VS SKIP LIST, SCORES IN [0, 1M)\n";
+
+    runLeaderboardUpdates("skip list", createLeaderboardWithConfig(0.5, 99));
+    runLeaderboardUpdates("fenwick", createFenwickLeaderboard(0, 999999));
+}
+
+void bench_Leaderboard_Percentiles() {
+    cout << "\n⏱ LEADERBOARD - PERCENTILES ON A 1M-PLAYER BOARD\n";
+
+    const int players = 1000000;
+    mt19937 rng(24);
+    vector<pair<int, int>> entries(players);
+    for (int i = 0; i < players; i++) entries[i] = { i, (int)(rng() % 1000000) };
+
+    Leaderboard* skipList = createLeaderboardWithConfig(0.5, 24);
+    Leaderboard* fenwick = createFenwickLeaderboard(0, 999999);
+    skipList->bulkLoad(entries);
+    fenwick->bulkLoad(entries);
+
+    // The old way: dump the board and count
+    bench.run("getTopN(INT_MAX) dump x10", 10, [&]() {
+        size_t total = 0;
+        for (int i = 0; i < 10; i++) total += skipList->getTopN(INT_MAX).size();
+        sink = total;
+    });
+
+    Leaderboard* boards[] = { skipList, fenwick };
+    const char* names[] = { "skip list", "fenwick" };
+    for (int b = 0; b < 2; b++) {
+        Leaderboard* board = boards[b];
+        bench.run(string(names[b]) + ": percentile x1M", 1000000, [&]() {
+            double total = 0;
+            for (int i = 0; i < 1000000; i++) total += board->percentile((int)(rng() % 1000000));
+            sink = (size_t)total;
+        });
+        bench.run(string(names[b]) + ": scoreAtPercentile x1M", 1000000, [&]() {
+            long long total = 0;
+            for (int i = 0; i < 1000000; i++) total += board->scoreAtPercentile((rng() % 10001) / 100.0);
+            sink = (size_t)total;
+        });
+        bench.run(string(names[b]) + ": 100-bucket histogram x10k", 10000, [&]() {
+            size_t total = 0;
+            for (int i = 0; i < 10000; i++) total += board->getScoreHistogram(0, 10000, 100).size();
+            sink = total;
+        });
+    }
+    delete skipList;
+    delete fenwick;
+}
+
+void bench_AuctionTree_Relisting() {
+    cout << "\n⏱ AUCTION TREE - RELISTING ON A 1M-ITEM TREE\n";
+
+    const int items = 1000000;
+    const int relists = 1000000;
+
+    mt19937 rng(25);
+    AuctionTree* tree = createAuctionTree();
+    bench.run("insertItem 1M new items", items, [&]() {
+        for (int i = 0; i < items; i++) tree->insertItem(i, (int)(rng() % 100000));
+    });
+    bench.run("relist 1M items at a new price", relists, [&]() {
+        for (int i = 0; i < relists; i++) tree->insertItem((int)(rng() % items), (int)(rng() % 100000));
+    });
+    bench.run("deleteItem 500k", 500000, [&]() {
+        for (int i = 0; i < 500000; i++) tree->deleteItem((int)(rng() % items));
+    });
+    delete tree;
+}
+
+// ==========================================
+// MAIN FUNCTION
+// ==========================================
+
+int main() {
+    cout << "Arcadia Engine - Benchmarks" << endl;
+    cout << "---------------------------" << endl;
+
+    bench_PlayerTable_Batch();
+    bench_PlayerTable_Concurrent();
+    bench_PlayerTable_WarmStart();
+    bench_PlayerTable_HashPolicies();
+    bench_Leaderboard_Updates();
+    bench_Leaderboard_Concurrent();
+    bench_Leaderboard_HotUpdates();
+    bench_Leaderboard_TopN();
+    bench_Leaderboard_Windowed();
+    bench_Leaderboard_WarmStart();
+    bench_Leaderboard_RankEvents();
+    bench_Leaderboard_Fenwick();
+    bench_Leaderboard_Percentiles();
+    bench_AuctionTree_Relisting();
+
+    return 0;
+}
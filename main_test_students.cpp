@@ -9,6 +9,16 @@
 #include <string>
 #include <iomanip>
 #include <functional>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <set>
+#include <map>
+#include <climits>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
 #include "ArcadiaEngine.h" 
 
 using namespace std;
@@ -19,7 +29,21 @@ using namespace std;
 // These link to the functions at the bottom of your .cpp file
 extern "C" {
     PlayerTable* createPlayerTable();
+    PlayerTable* createResizablePlayerTable();
+    PlayerTable* createFlatPlayerTable();
+    PlayerTable* createShardedPlayerTable(int shardCount);
+    PlayerTable* loadPlayerTableSnapshot(const char* path);
+    PlayerTable* createPrimePlayerTable();
+    PlayerTable* createIndexedPlayerTable();
+    PlayerTable* createFibonacciPlayerTable();
     Leaderboard* createLeaderboard();
+    Leaderboard* createLeaderboardWithConfig(double p, unsigned long long seed);
+    Leaderboard* createConcurrentLeaderboard();
+    Leaderboard* createBufferedLeaderboard(bool additive);
+    Leaderboard* createShardedLeaderboard(int shardCount);
+    Leaderboard* createWindowedLeaderboard(int bucketCount, WindowPolicy policy);
+    Leaderboard* createFenwickLeaderboard(int minScore, int maxScore);
+    Leaderboard* loadLeaderboardSnapshot(const char* path);
     AuctionTree* createAuctionTree();
 }
 
@@ -69,6 +93,30 @@ StudentTestRunner runner;
 // HASH TABLE - STRONG TESTS
 // ==========================================
 
+// PlayerTable flavours that share the basic insert/remove/search contract;
+// fixed ones hold at most 101 players
+struct TableKind {
+    const char* label;
+    PlayerTable* (*create)();
+    bool fixed;
+};
+
+const TableKind TABLE_KINDS[] = {
+    { "Fixed", createPlayerTable, true },
+    { "Resizable", createResizablePlayerTable, false },
+    { "Flat", createFlatPlayerTable, false },
+    { "Static", createPrimePlayerTable, true },
+};
+
+// Runs body on a fresh table of every kind
+void forEachTableKind(const function<void(PlayerTable*, const TableKind&)>& body) {
+    for (const TableKind& kind : TABLE_KINDS) {
+        PlayerTable* table = kind.create();
+        body(table, kind);
+        delete table;
+    }
+}
+
 void test_HashTable_DoubleHashing() {
     cout << "\n🔍 HASH TABLE - DOUBLE HASHING TESTS\n";
 
@@ -169,6 +217,653 @@ void test_HashTable_TombstoneHandling() {
         return table->search(202) == "C_updated";
         }());
 
+    // Test removing the middle of the chain for real
+    runner.runTest("HashTable: Remove leaves chain searchable", [&]() {
+        table->remove(101);
+        return table->search(101) == "" &&
+            table->search(202) == "C_updated" &&
+            table->search(303) == "D" &&
+            table->tombstoneRatio() > 0.0;
+        }());
+
+    runner.runTest("HashTable: Reinsert reuses the tombstone", [&]() {
+        table->insert(101, "B2");
+        return table->search(101) == "B2" && table->search(303) == "D";
+        }());
+
+    delete table;
+}
+
+void test_HashTable_RemoveChurn() {
+    cout << "\n🔍 HASH TABLE - REMOVE UNDER CHURN\n";
+
+    forEachTableKind([&](PlayerTable* table, const TableKind& kind) {
+        int live = kind.fixed ? 60 : 2000;
+        string padding(32, 'n');  // 2 MB of names over the run without compaction
+
+        // Sliding window of live IDs: every round inserts one and removes the oldest
+        runner.runTest(string("Churn (") + kind.label + "): 50k insert/remove rounds", [&]() {
+            try {
+                for (int i = 0; i < 50000; i++) {
+                    table->insert(i, padding + to_string(i));
+                    if (i >= live) table->remove(i - live);
+                }
+            }
+            catch (...) {
+                return false;
+            }
+            for (int i = 50000 - live; i < 50000; i++) {
+                if (table->search(i) != padding + to_string(i)) return false;
+            }
+            return table->search(50000 - live - 1) == "" && table->search(0) == "";
+            }());
+
+        // Removed names are compacted away: a few 64 KB blocks at most
+        runner.runTest(string("Churn (") + kind.label + "): Name arena and tombstones stay bounded", [&]() {
+            PlayerTableStats stats = table->stats();
+            return stats.nameArenaBytes <= 4 * 64 * 1024 && stats.tombstoneRatio <= 0.5;
+            }());
+    });
+
+    // Held one insert short of the growth threshold, each round leaves one
+    // more tombstone; those must not trigger a full rebuild every few rounds.
+    // Each rebuild walks the whole table, so bound the slots touched per round.
+    runner.runTest("Churn (Resizable): Inserts at the load limit rarely rebuild", [&]() {
+        PlayerTable* table = createResizablePlayerTable();
+        int live = (int)(table->stats().capacity * 0.7) - 1;
+        int rounds = 20000;
+        bool ok = true;
+        for (int i = 0; i < live + rounds; i++) {
+            table->insert(i, "P" + to_string(i));
+            if (i >= live) table->remove(i - live);
+        }
+        for (int i = rounds; i < live + rounds; i++) {
+            ok = ok && table->search(i) == "P" + to_string(i);
+        }
+        ok = ok && table->search(rounds - 1) == "";
+        PlayerTableStats stats = table->stats();
+        delete table;
+        return ok && stats.rebuilds * stats.capacity <= 8LL * rounds;
+        }());
+}
+
+void test_HashTable_Resizable() {
+    cout << "\n🔍 HASH TABLE - RESIZABLE MODE\n";
+
+    PlayerTable* table = createResizablePlayerTable();
+
+    // Test 1: Grows well past the fixed 101-slot capacity
+    runner.runTest("HashTable: Resizable grows past 101 players", [&]() {
+        try {
+            for (int i = 0; i < 50000; i++) {
+                table->insert(i * 7, "Player" + to_string(i));
+            }
+        }
+        catch (...) {
+            return false;
+        }
+        return table->search(0) == "Player0" &&
+            table->search(49999 * 7) == "Player49999";
+        }());
+
+    // Test 2: Every entry survives the incremental migrations
+    runner.runTest("HashTable: All entries found after rehashing", [&]() {
+        for (int i = 0; i < 50000; i++) {
+            if (table->search(i * 7) != "Player" + to_string(i)) return false;
+        }
+        return table->search(3) == "";
+        }());
+
+    // Test 3: Updates while a migration is in progress
+    runner.runTest("HashTable: Updates during migration", [&]() {
+        PlayerTable* small = createResizablePlayerTable();
+        bool ok = true;
+        for (int i = 0; i < 1000; i++) {
+            small->insert(i, "A" + to_string(i));
+            small->insert(i / 2, "B" + to_string(i / 2));
+        }
+        for (int i = 0; i < 1000; i++) {
+            string expected = (i < 500 ? "B" : "A") + to_string(i);
+            if (small->search(i) != expected) ok = false;
+        }
+        delete small;
+        return ok;
+        }());
+
+    delete table;
+}
+
+void test_HashTable_FlatLayout() {
+    cout << "\n🔍 HASH TABLE - FLAT CONTROL-BYTE LAYOUT\n";
+
+    PlayerTable* table = createFlatPlayerTable();
+
+    // Test 1: Same interface behavior as the double hashing table
+    runner.runTest("FlatTable: Insert, update and miss", [&]() {
+        table->insert(100, "Alice");
+        table->insert(0, "Player0");
+        table->insert(101, "Player101");
+        table->insert(100, "AliceUpdated");
+        return table->search(100) == "AliceUpdated" &&
+            table->search(0) == "Player0" &&
+            table->search(101) == "Player101" &&
+            table->search(99999) == "";
+        }());
+
+    // Test 2: Grows across many groups, including negative IDs
+    runner.runTest("FlatTable: 100k players across rehashes", [&]() {
+        for (int i = -50000; i < 50000; i++) {
+            table->insert(i * 16, "P" + to_string(i));
+        }
+        for (int i = -50000; i < 50000; i++) {
+            if (table->search(i * 16) != "P" + to_string(i)) return false;
+        }
+        return table->search(17) == "";
+        }());
+
+    delete table;
+}
+
+void test_HashTable_NameViews() {
+    cout << "\n🔍 HASH TABLE - ARENA NAMES AND VIEWS\n";
+
+    forEachTableKind([&](PlayerTable* table, const TableKind& kind) {
+        string prefix = string("NameView (") + kind.label + "): ";
+
+        // Test 1: searchView matches search, long names included
+        runner.runTest(prefix + "View matches stored name", [&]() {
+            string longName(200, 'x');
+            table->insert(7, "Short");
+            table->insert(8, longName);
+            return table->searchView(7) == "Short" &&
+                table->searchView(8) == longName &&
+                table->search(8) == longName &&
+                table->searchView(9).empty();
+            }());
+
+        // Test 2: Heavy updates trigger arena compaction without losing names
+        runner.runTest(prefix + "Names survive compaction", [&]() {
+            for (int round = 0; round < 200; round++) {
+                for (int id = 0; id < 50; id++) {
+                    table->insert(id, string(64, 'a' + (round % 26)) + to_string(id));
+                }
+            }
+            for (int id = 0; id < 50; id++) {
+                if (table->searchView(id) != string(64, 'a' + (199 % 26)) + to_string(id)) return false;
+            }
+            return true;
+            }());
+    });
+}
+
+void test_HashTable_Batch() {
+    cout << "\n🔍 HASH TABLE - BATCHED OPERATIONS\n";
+
+    forEachTableKind([&](PlayerTable* table, const TableKind& kind) {
+        int count = kind.fixed ? 90 : 5000;
+
+        vector<pair<int, string>> entries;
+        vector<int> ids;
+        for (int i = 0; i < count; i++) {
+            entries.push_back({ i * 101, "P" + to_string(i) });  // All collide under %101
+            ids.push_back(i * 101);
+            ids.push_back(i * 101 + 1);  // Misses
+        }
+
+        runner.runTest(string("Batch (") + kind.label + "): searchBatch matches search", [&]() {
+            table->insertBatch(entries);
+            vector<string_view> results;
+            table->searchBatch(ids, results);
+            if (results.size() != ids.size()) return false;
+            for (size_t i = 0; i < ids.size(); i++) {
+                if (results[i] != table->searchView(ids[i])) return false;
+                if (i % 2 == 0 && results[i] != "P" + to_string(i / 2)) return false;
+                if (i % 2 == 1 && !results[i].empty()) return false;
+            }
+            return true;
+            }());
+
+#if !defined(ARCADIA_TABLE_STATS) || ARCADIA_TABLE_STATS
+        runner.runTest(string("Batch (") + kind.label + "): searchBatch feeds the probe stats", [&]() {
+            long long before = table->stats().searchOps;
+            vector<string_view> results;
+            table->searchBatch(ids, results);
+            PlayerTableStats s = table->stats();
+            return s.searchOps == before + (long long)ids.size() && s.maxSearchProbes >= 1;
+            }());
+#endif
+    });
+}
+
+void test_HashTable_Concurrent() {
+    cout << "\n🔍 HASH TABLE - SHARDED CONCURRENT ACCESS\n";
+
+    PlayerTable* table = createShardedPlayerTable(16);
+
+    // Test 1: Writers on disjoint ranges while readers poll
+    runner.runTest("Sharded: Parallel writers and readers", [&]() {
+        const int writers = 4;
+        const int perWriter = 20000;
+        atomic<bool> readerSawWrongName(false);
+        atomic<bool> done(false);
+
+        vector<thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < perWriter; i++) {
+                    int id = w * perWriter + i;
+                    table->insert(id, "P" + to_string(id));
+                    if (i % 3 == 0) table->remove(id);
+                }
+            });
+        }
+        for (int r = 0; r < 2; r++) {
+            threads.emplace_back([&, r]() {
+                while (!done) {
+                    for (int id = r; id < writers * perWriter; id += 97) {
+                        string name = table->search(id);
+                        if (!name.empty() && name != "P" + to_string(id)) readerSawWrongName = true;
+                    }
+                }
+            });
+        }
+        for (int w = 0; w < writers; w++) threads[w].join();
+        done = true;
+        for (size_t t = writers; t < threads.size(); t++) threads[t].join();
+
+        for (int id = 0; id < writers * perWriter; id++) {
+            string expected = ((id % perWriter) % 3 == 0) ? "" : "P" + to_string(id);
+            if (table->search(id) != expected) return false;
+        }
+        return !readerSawWrongName;
+        }());
+
+    delete table;
+}
+
+void test_HashTable_Snapshot() {
+    cout << "\n🔍 HASH TABLE - MAPPED SNAPSHOT\n";
+
+    const char* path = "arcadia_player_snapshot.bin";
+    PlayerTable* source = createResizablePlayerTable();
+    for (int i = 0; i < 3000; i++) {
+        source->insert(i * 101, "P" + to_string(i));
+    }
+    for (int i = 0; i < 3000; i += 4) {
+        source->remove(i * 101);  // Tombstones must not leak into the file
+    }
+    source->saveSnapshot(path);
+
+    PlayerTable* loaded = loadPlayerTableSnapshot(path);
+
+    // Test 1: Mapped table answers from the file
+    runner.runTest("Snapshot: Mapped search matches source", [&]() {
+        for (int i = 0; i < 3000; i++) {
+            if (loaded->searchView(i * 101) != source->searchView(i * 101)) return false;
+        }
+        return loaded->search(5) == "";
+        }());
+
+    // Test 2: First mutation promotes to an in-memory table
+    runner.runTest("Snapshot: Mutations after load", [&]() {
+        loaded->insert(1, "New");
+        loaded->insert(101, "Renamed");
+        loaded->remove(202);
+        return loaded->search(1) == "New" &&
+            loaded->search(101) == "Renamed" &&
+            loaded->search(202) == "" &&
+            loaded->search(303) == "P3";
+        }());
+
+    // Test 3: Garbage is rejected
+    runner.runTest("Snapshot: Rejects invalid file", [&]() {
+        FILE* f = fopen(path, "wb");
+        fputs("not a snapshot", f);
+        fclose(f);
+        try {
+            PlayerTable* bad = loadPlayerTableSnapshot(path);
+            delete bad;
+            return false;
+        }
+        catch (const char*) {
+            return true;
+        }
+        }());
+
+    // Test 4: Well-formed header, but a name or the blob size points
+    // outside the file
+    runner.runTest("Snapshot: Rejects corrupt name offset and blob size", [&]() {
+        PlayerTable* small = createPlayerTable();
+        small->insert(7, "Seven");
+        small->saveSnapshot(path);
+        delete small;
+
+        FILE* f = fopen(path, "rb");
+        vector<char> bytes;
+        for (int c = fgetc(f); c != EOF; c = fgetc(f)) bytes.push_back((char)c);
+        fclose(f);
+
+        // Header is 32 bytes; slots are {playerID, occupied, nameOffset, nameLength}
+        const size_t headerBytes = 32, slotBytes = 16;
+        vector<char> badOffset = bytes;
+        for (size_t at = headerBytes; at + slotBytes <= bytes.size(); at += slotBytes) {
+            int32_t fields[4];
+            memcpy(fields, &bytes[at], sizeof(fields));
+            if (fields[0] == 7 && fields[1] == 1) {
+                fields[2] = 1 << 30;
+                memcpy(&badOffset[at], fields, sizeof(fields));
+            }
+        }
+        vector<char> badBlobSize = bytes;
+        uint64_t hugeBlob = ~0ULL - 8;
+        memcpy(&badBlobSize[24], &hugeBlob, sizeof(hugeBlob));
+
+        int rejected = 0;
+        for (const vector<char>* corrupt : { &badOffset, &badBlobSize }) {
+            f = fopen(path, "wb");
+            fwrite(corrupt->data(), 1, corrupt->size(), f);
+            fclose(f);
+            try {
+                PlayerTable* bad = loadPlayerTableSnapshot(path);
+                delete bad;
+            }
+            catch (const char*) {
+                rejected++;
+            }
+        }
+        return badOffset != bytes && rejected == 2;
+        }());
+
+    remove(path);
+    delete source;
+    delete loaded;
+}
+
+void test_HashTable_Stats() {
+    cout << "\n🔍 HASH TABLE - PROBE STATISTICS\n";
+
+    PlayerTable* table = createPlayerTable();
+    table->insert(0, "A");
+    table->insert(101, "B");  // Collides with 0
+    table->insert(202, "C");  // Collides with 0, found on the second probe
+    table->insert(5, "D");
+    table->search(202);
+    table->search(99999);
+
+    PlayerTableStats s = table->stats();
+
+    runner.runTest("Stats: Size, capacity and load factor", [&]() {
+        return s.size == 4 && s.capacity == 101 && s.loadFactor > 0.039 && s.loadFactor < 0.04;
+        }());
+
+    runner.runTest("Stats: Clusters cover every used slot", [&]() {
+        long long used = 0;
+        for (size_t k = 0; k < s.clusterHistogram.size(); k++) {
+            used += s.clusterHistogram[k] * (long long)(k + 1);
+        }
+        return used == 4 && s.maxClusterSize >= 1;
+        }());
+
+#if !defined(ARCADIA_TABLE_STATS) || ARCADIA_TABLE_STATS
+    runner.runTest("Stats: Probe counters track collisions", [&]() {
+        long long histogramOps = 0;
+        for (long long count : s.probeHistogram) histogramOps += count;
+        return s.insertOps == 4 && s.searchOps == 2 &&
+            s.maxInsertProbes >= 2 && s.maxSearchProbes == 2 &&
+            histogramOps == 6;
+        }());
+#endif
+
+    delete table;
+}
+
+void test_HashTable_StaticPolicies() {
+    cout << "\n🔍 HASH TABLE - COMPILE-TIME HASH POLICIES\n";
+
+    // Test 1: Negative IDs no longer index out of range
+    runner.runTest("HashTable: Negative IDs", [&]() {
+        PlayerTable* table = createResizablePlayerTable();
+        for (int i = 1; i <= 1000; i++) table->insert(-i, "N" + to_string(i));
+        bool ok = table->search(-1) == "N1" && table->search(-1000) == "N1000" && table->search(1) == "";
+        delete table;
+        return ok;
+        }());
+
+    // Test 2: Prime policy keeps the fixed table's contract
+    runner.runTest("PrimeTable: Full at 101 like the original", [&]() {
+        PlayerTable* table = createPrimePlayerTable();
+        bool threw = false;
+        for (int i = 0; i < 101; i++) table->insert(i * 1000, "P" + to_string(i));
+        try {
+            table->insert(999999, "ShouldFail");
+        }
+        catch (const char* msg) {
+            threw = string(msg) == "Table is full";
+        }
+        bool ok = threw && table->search(0) == "P0" && table->search(100000) == "P100";
+        delete table;
+        return ok;
+        }());
+
+    // Test 3: Fibonacci policy with colliding, negative and removed keys
+    runner.runTest("FibonacciTable: Insert, remove, search", [&]() {
+        PlayerTable* table = createFibonacciPlayerTable();
+        for (int i = -20000; i < 20000; i++) table->insert(i * 2048, "F" + to_string(i));
+        for (int i = -20000; i < 20000; i += 2) table->remove(i * 2048);
+        bool ok = true;
+        for (int i = -20000; i < 20000; i++) {
+            string expected = (i % 2 == 0) ? "" : "F" + to_string(i);
+            if (table->search(i * 2048) != expected) ok = false;
+        }
+        delete table;
+        return ok;
+        }());
+
+    // Test 4: Renames compact the arena instead of piling up old names
+    runner.runTest("PrimeTable: Renames keep the name arena bounded", [&]() {
+        PlayerTable* table = createPrimePlayerTable();
+        string padding(32, 'r');  // 12 MB of names without compaction
+        for (int round = 0; round < 30000; round++) {
+            for (int id = 0; id < 10; id++) table->insert(id, padding + to_string(round));
+        }
+        bool ok = table->search(3) == padding + "29999" &&
+            table->stats().nameArenaBytes <= 4 * 64 * 1024;
+        delete table;
+        return ok;
+        }());
+}
+
+void test_HashTable_NameIndex() {
+    cout << "\n🔍 HASH TABLE - REVERSE NAME INDEX\n";
+
+    PlayerTable* table = createIndexedPlayerTable();
+
+    runner.runTest("NameIndex: Lookup by name, shared names", [&]() {
+        table->insert(1, "Alice");
+        table->insert(2, "Bob");
+        table->insert(3, "Alice");
+        vector<int> alices = table->searchByName("Alice");
+        return alices == vector<int>{ 1, 3 } &&
+            table->searchByName("Bob") == vector<int>{ 2 } &&
+            table->searchByName("Carol").empty();
+        }());
+
+    runner.runTest("NameIndex: Follows renames and removals", [&]() {
+        table->insert(3, "Carol");
+        table->remove(2);
+        return table->searchByName("Alice") == vector<int>{ 1 } &&
+            table->searchByName("Carol") == vector<int>{ 3 } &&
+            table->searchByName("Bob").empty();
+        }());
+
+    runner.runTest("NameIndex: Survives growth and arena compaction", [&]() {
+        for (int round = 0; round < 50; round++) {
+            for (int id = 100; id < 2100; id++) {
+                table->insert(id, "Name" + to_string(round) + "_" + to_string(id));
+            }
+        }
+        for (int id = 100; id < 2100; id++) {
+            if (table->searchByName("Name49_" + to_string(id)) != vector<int>{ id }) return false;
+        }
+        return table->searchByName("Name0_100").empty();
+        }());
+
+    runner.runTest("NameIndex: Unindexed tables refuse", [&]() {
+        PlayerTable* plain = createPlayerTable();
+        bool threw = false;
+        try {
+            plain->searchByName("Alice");
+        }
+        catch (const char*) {
+            threw = true;
+        }
+        delete plain;
+        return threw;
+        }());
+
+    delete table;
+}
+
+void test_HashTable_SessionTTL() {
+    cout << "\n🔍 HASH TABLE - SESSION TTL EXPIRY\n";
+
+    PlayerTable* table = createResizablePlayerTable();
+
+    runner.runTest("TTL: Entry expires exactly at its deadline", [&]() {
+        table->insertWithTTL(1, "Short", 10);
+        table->insert(2, "Permanent");
+        table->advanceTime(9);
+        bool aliveBefore = table->search(1) == "Short";
+        table->advanceTime(1);
+        return aliveBefore && table->search(1) == "" && table->search(2) == "Permanent";
+        }());
+
+    runner.runTest("TTL: Refresh extends, remove cancels", [&]() {
+        table->insertWithTTL(3, "Refreshed", 50);
+        table->advanceTime(40);
+        table->insertWithTTL(3, "Refreshed", 50);  // New deadline 40 + 50
+        table->insertWithTTL(4, "Removed", 20);
+        table->remove(4);
+        table->insert(4, "Back");                   // Plain insert, no TTL
+        table->advanceTime(30);
+        bool refreshed = table->search(3) == "Refreshed";
+        table->advanceTime(20);
+        return refreshed && table->search(3) == "" && table->search(4) == "Back";
+        }());
+
+    runner.runTest("TTL: Long TTLs cascade through every wheel level", [&]() {
+        // Spread deadlines over several levels and past the 2^24 horizon
+        vector<long long> ttls = { 63, 64, 65, 4095, 4096, 4097, 262143, 262145, 16777215, 16777216, 20000000 };
+        for (size_t i = 0; i < ttls.size(); i++) {
+            table->insertWithTTL(1000 + (int)i, "T" + to_string(i), ttls[i]);
+        }
+        long long elapsed = 0;
+        for (size_t i = 0; i < ttls.size(); i++) {
+            table->advanceTime(ttls[i] - 1 - elapsed);
+            elapsed = ttls[i] - 1;
+            if (table->search(1000 + (int)i) != "T" + to_string(i)) return false;
+            table->advanceTime(1);
+            elapsed++;
+            if (table->search(1000 + (int)i) != "") return false;
+        }
+        return true;
+        }());
+
+    runner.runTest("TTL: Random schedule matches brute force", [&]() {
+        PlayerTable* t = createResizablePlayerTable();
+        vector<long long> deadline(500, -1);
+        long long now = 0;
+        unsigned int seed = 12345;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8) % 5000; };
+        for (int step = 0; step < 2000; step++) {
+            int id = (int)(next() % 500);
+            long long ttl = 1 + next() % 3000;
+            t->insertWithTTL(id, "S", ttl);
+            deadline[id] = now + ttl;
+            long long delta = next() % 7;
+            t->advanceTime(delta);
+            now += delta;
+            for (int p = 0; p < 500; p++) {
+                bool alive = deadline[p] > now;
+                if ((t->search(p) == "S") != alive) {
+                    delete t;
+                    return false;
+                }
+            }
+        }
+        delete t;
+        return true;
+        }());
+
+    // Stepping tick by tick, these advances would take minutes
+    runner.runTest("TTL: Advance jumps over empty and cancelled timers", [&]() {
+        PlayerTable* t = createPlayerTable();
+        t->insertWithTTL(1, "Gone", 100000000);
+        t->remove(1);
+        t->advanceTime(100000000);
+        t->insertWithTTL(2, "Far", 50000000000LL);
+        t->insertWithTTL(3, "Near", 30000000);
+        t->advanceTime(29999999);
+        bool ok = t->search(3) == "Near";
+        t->advanceTime(1);
+        ok = ok && t->search(3) == "" && t->search(2) == "Far";
+        t->advanceTime(50000000000LL - 30000001);
+        ok = ok && t->search(2) == "Far";
+        t->advanceTime(1);
+        ok = ok && t->search(2) == "";
+        delete t;
+        return ok;
+        }());
+
+    // Expiry goes through remove(), so expired names must be compacted too
+    runner.runTest("TTL: Bursty short sessions keep memory bounded", [&]() {
+        bool ok = true;
+        for (PlayerTable* t : { createPlayerTable(), createResizablePlayerTable() }) {
+            string padding(32, 's');  // 12 MB of names without compaction
+            for (int i = 0; i < 300000; i++) {
+                t->insertWithTTL(i, padding + to_string(i), 10);  // About 10 live at a time
+                t->advanceTime(1);
+            }
+            PlayerTableStats stats = t->stats();
+            ok = ok && stats.size <= 10 && stats.nameArenaBytes <= 4 * 64 * 1024 &&
+                t->search(299999) == padding + "299999";
+            delete t;
+        }
+        return ok;
+        }());
+
+    runner.runTest("TTL: Sparse random schedule matches brute force", [&]() {
+        PlayerTable* t = createPlayerTable();
+        vector<long long> deadline(100, -1);
+        long long now = 0;
+        unsigned int seed = 54321;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (long long)(seed >> 4); };
+        for (int step = 0; step < 1500; step++) {
+            int id = (int)(next() % 100);
+            if (next() % 4 == 0) {
+                t->remove(id);
+                deadline[id] = -1;
+            }
+            else {
+                long long ttl = 1 + next() % 40000000;
+                t->insertWithTTL(id, "S", ttl);
+                deadline[id] = now + ttl;
+            }
+            long long delta = next() % 3000000;
+            t->advanceTime(delta);
+            now += delta;
+            for (int p = 0; p < 100; p++) {
+                bool alive = deadline[p] > now;
+                if ((t->search(p) == "S") != alive) {
+                    delete t;
+                    return false;
+                }
+            }
+        }
+        delete t;
+        return true;
+        }());
+
     delete table;
 }
 
@@ -334,6 +1029,1006 @@ void test_SkipList_getTopN_EdgeCases() {
     delete board;
 }
 
+// Reference ordering for randomized leaderboard checks: higher score first,
+// then lower ID
+struct BoardReference {
+    map<int, int> scoreOf;
+    set<pair<int, int>> order;  // (-score, playerID)
+
+    void addScore(int playerID, int score) {
+        removePlayer(playerID);
+        scoreOf[playerID] = score;
+        order.insert({ -score, playerID });
+    }
+    void removePlayer(int playerID) {
+        auto it = scoreOf.find(playerID);
+        if (it == scoreOf.end()) return;
+        order.erase({ -it->second, playerID });
+        scoreOf.erase(it);
+    }
+    vector<int> topN(int n) const {
+        vector<int> result;
+        for (auto it = order.begin(); it != order.end() && (int)result.size() < n; ++it) {
+            result.push_back(it->second);
+        }
+        return result;
+    }
+};
+
+void test_SkipList_RandomizedUpdates() {
+    cout << "\n🔍 SKIP LIST - RANDOMIZED UPDATES VS REFERENCE\n";
+
+    Leaderboard* board = createLeaderboard();
+    BoardReference reference;
+
+    runner.runTest("SkipList: 20k random add/update/remove", [&]() {
+        unsigned int seed = 2024;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        for (int step = 0; step < 20000; step++) {
+            int id = (int)(next() % 3000);
+            if (next() % 5 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 500);  // Many ties
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        return board->getTopN(5000) == reference.topN(5000);
+        }());
+
+    delete board;
+}
+
+void test_SkipList_RankQueries() {
+    cout << "\n🔍 SKIP LIST - RANK AND SCORE-RANGE QUERIES\n";
+
+    runner.runTest("SkipList: getRank/getByRank basic", [&]() {
+        Leaderboard* board = createLeaderboard();
+        board->addScore(10, 300);
+        board->addScore(20, 500);
+        board->addScore(30, 300);
+        board->addScore(40, 100);
+        // Order: 20(500), 10(300), 30(300), 40(100)
+        bool ok = board->getRank(20) == 1 && board->getRank(10) == 2 &&
+            board->getRank(30) == 3 && board->getRank(40) == 4 &&
+            board->getRank(99) == -1 &&
+            board->getByRank(1) == 20 && board->getByRank(3) == 30 &&
+            board->getByRank(0) == -1 && board->getByRank(5) == -1;
+        board->removePlayer(10);
+        ok = ok && board->getRank(30) == 2 && board->getByRank(3) == 40;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("SkipList: Window around a player is clipped", [&]() {
+        Leaderboard* board = createLeaderboard();
+        for (int i = 1; i <= 10; i++) board->addScore(i, 1000 - i);
+        bool ok = board->getPlayersAroundRank(board->getRank(5), 2) == vector<int>({ 3, 4, 5, 6, 7 }) &&
+            board->getPlayersAroundRank(1, 2) == vector<int>({ 1, 2, 3 }) &&
+            board->getPlayersAroundRank(10, 1) == vector<int>({ 9, 10 }) &&
+            board->getPlayersAroundRank(20, 3).empty();
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("SkipList: Score range count and list", [&]() {
+        Leaderboard* board = createLeaderboard();
+        board->addScore(1, 50);
+        board->addScore(2, 70);
+        board->addScore(3, 70);
+        board->addScore(4, 90);
+        board->addScore(5, 10);
+        bool ok = board->countInScoreRange(50, 70) == 3 &&
+            board->getPlayersInScoreRange(50, 70) == vector<int>({ 2, 3, 1 }) &&
+            board->countInScoreRange(INT_MIN, INT_MAX) == 5 &&
+            board->countInScoreRange(71, 89) == 0 &&
+            board->getPlayersInScoreRange(71, 89).empty() &&
+            board->countInScoreRange(70, 50) == 0;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("SkipList: Ranks match reference after churn", [&]() {
+        Leaderboard* board = createLeaderboard();
+        BoardReference reference;
+        unsigned int seed = 77;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        for (int step = 0; step < 5000; step++) {
+            int id = (int)(next() % 800);
+            if (next() % 4 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 200);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        vector<int> ranking = reference.topN(INT_MAX);
+        bool ok = true;
+        for (int r = 1; r <= (int)ranking.size(); r++) {
+            ok = ok && board->getByRank(r) == ranking[r - 1] && board->getRank(ranking[r - 1]) == r;
+        }
+        for (int lo = 0; lo < 200; lo += 37) {
+            int hi = lo + 45;
+            vector<int> expected;
+            for (int id : ranking) {
+                int s = reference.scoreOf[id];
+                if (s >= lo && s <= hi) expected.push_back(id);
+            }
+            ok = ok && board->countInScoreRange(lo, hi) == (int)expected.size() &&
+                board->getPlayersInScoreRange(lo, hi) == expected;
+        }
+        delete board;
+        return ok;
+        }());
+}
+
+void test_SkipList_Config() {
+    cout << "\n🔍 SKIP LIST - PROMOTION PROBABILITY AND SEED\n";
+
+    runner.runTest("SkipList: p=1/4 board matches reference", [&]() {
+        Leaderboard* board = createLeaderboardWithConfig(0.25, 12345);
+        BoardReference reference;
+        unsigned int seed = 5;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        for (int step = 0; step < 20000; step++) {
+            int id = (int)(next() % 5000);
+            if (next() % 6 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 1000);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        vector<int> ranking = reference.topN(INT_MAX);
+        bool ok = board->getTopN(INT_MAX) == ranking;
+        for (int r = 1; r <= (int)ranking.size(); r += 97) {
+            ok = ok && board->getByRank(r) == ranking[r - 1];
+        }
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("SkipList: Seed 0 and p near 1 still work", [&]() {
+        Leaderboard* board = createLeaderboardWithConfig(0.9, 0);
+        for (int i = 0; i < 2000; i++) board->addScore(i, i % 50);
+        bool ok = board->getRank(49) == 1 && board->getByRank(2000) == 1950;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("SkipList: Invalid promotion probability throws", [&]() {
+        int thrown = 0;
+        double bad[] = { 0.0, 1.0, -0.5, 2.0 };
+        for (double p : bad) {
+            try {
+                Leaderboard* board = createLeaderboardWithConfig(p, 1);
+                delete board;
+            }
+            catch (const char*) {
+                thrown++;
+            }
+        }
+        return thrown == 4;
+        }());
+}
+
+void test_SkipList_Concurrent() {
+    cout << "\n🔍 SKIP LIST - CONCURRENT UPDATES AND READERS\n";
+
+    runner.runTest("Concurrent: Single-threaded matches reference", [&]() {
+        Leaderboard* board = createConcurrentLeaderboard();
+        BoardReference reference;
+        unsigned int seed = 31;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        for (int step = 0; step < 20000; step++) {
+            int id = (int)(next() % 3000);
+            if (next() % 5 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 500);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        bool ok = board->getTopN(INT_MAX) == reference.topN(INT_MAX) &&
+            board->getTopN(7) == reference.topN(7);
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("Concurrent: Parallel writers with polling readers", [&]() {
+        Leaderboard* board = createConcurrentLeaderboard();
+        const int writers = 4;
+        const int perWriter = 2000;
+        vector<map<int, int>> finalScores(writers);
+        atomic<bool> readerSawBadID(false);
+        atomic<bool> done(false);
+
+        vector<thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w]() {
+                unsigned int seed = 100 + w;
+                auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+                for (int step = 0; step < 20000; step++) {
+                    int id = w * perWriter + (int)(next() % perWriter);
+                    if (next() % 4 == 0) {
+                        board->removePlayer(id);
+                        finalScores[w].erase(id);
+                    }
+                    else {
+                        int score = (int)(next() % 300);
+                        board->addScore(id, score);
+                        finalScores[w][id] = score;
+                    }
+                }
+            });
+        }
+        for (int r = 0; r < 2; r++) {
+            threads.emplace_back([&]() {
+                while (!done) {
+                    vector<int> top = board->getTopN(50);
+                    if (top.size() > 50) readerSawBadID = true;
+                    for (int id : top) {
+                        if (id < 0 || id >= writers * perWriter) readerSawBadID = true;
+                    }
+                }
+            });
+        }
+        for (int w = 0; w < writers; w++) threads[w].join();
+        done = true;
+        for (size_t t = writers; t < threads.size(); t++) threads[t].join();
+
+        BoardReference reference;
+        for (auto& scores : finalScores) {
+            for (auto& entry : scores) reference.addScore(entry.first, entry.second);
+        }
+        bool ok = board->getTopN(INT_MAX) == reference.topN(INT_MAX) && !readerSawBadID;
+        delete board;
+        return ok;
+        }());
+
+    // A few players jumping between the top and bottom of the list are
+    // often seen mid-move; none may be listed twice
+    runner.runTest("Concurrent: Moving players are never listed twice", [&]() {
+        Leaderboard* board = createConcurrentLeaderboard();
+        const int players = 8;
+        for (int id = 0; id < players; id++) board->addScore(id, id);
+        atomic<bool> readerSawDuplicate(false);
+        atomic<bool> done(false);
+
+        vector<thread> threads;
+        for (int w = 0; w < 2; w++) {
+            threads.emplace_back([&, w]() {
+                for (int step = 0; step < 50000; step++) {
+                    int id = (step * 2 + w) % players;
+                    board->addScore(id, step % 2 ? 1000 + step : -step);
+                }
+            });
+        }
+        threads.emplace_back([&]() {
+            while (!done) {
+                vector<int> top = board->getTopN(players);
+                set<int> distinct(top.begin(), top.end());
+                if (distinct.size() != top.size()) readerSawDuplicate = true;
+            }
+        });
+        for (int w = 0; w < 2; w++) threads[w].join();
+        done = true;
+        threads[2].join();
+
+        bool ok = board->getTopN(INT_MAX).size() == (size_t)players && !readerSawDuplicate;
+        delete board;
+        return ok;
+        }());
+}
+
+void test_SkipList_Buffered() {
+    cout << "\n🔍 SKIP LIST - COALESCING WRITE BUFFER\n";
+
+    runner.runTest("Buffered: Last-write-wins matches reference", [&]() {
+        Leaderboard* board = createBufferedLeaderboard(false);
+        BoardReference reference;
+        unsigned int seed = 11;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        bool ok = true;
+        for (int step = 0; step < 30000; step++) {
+            int id = (int)(next() % 400);  // Few hot players, many repeats
+            if (next() % 7 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 1000);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+            if (step % 5000 == 0) ok = ok && board->getTopN(20) == reference.topN(20);
+        }
+        ok = ok && board->getTopN(INT_MAX) == reference.topN(INT_MAX);
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("Buffered: Additive updates sum per player", [&]() {
+        Leaderboard* board = createBufferedLeaderboard(true);
+        board->addScore(1, 10);
+        board->addScore(2, 5);
+        board->addScore(1, 10);
+        board->addScore(2, 30);
+        // 2 -> 35, 1 -> 20
+        bool ok = board->getTopN(2) == vector<int>({ 2, 1 });
+        board->addScore(1, 20);  // Builds on the applied 20
+        ok = ok && board->getTopN(2) == vector<int>({ 1, 2 }) && board->getRank(1) == 1;
+        board->addScore(2, 100);
+        board->removePlayer(2);
+        board->addScore(2, 7);  // Starts over from 0 after the removal
+        board->flush();
+        ok = ok && board->getTopN(2) == vector<int>({ 1, 2 }) &&
+            board->countInScoreRange(7, 7) == 1 && board->countInScoreRange(40, 40) == 1;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("Buffered: Reads see pending writes", [&]() {
+        Leaderboard* board = createBufferedLeaderboard(false);
+        board->addScore(5, 50);
+        board->addScore(6, 60);
+        bool ok = board->getByRank(1) == 6 && board->getRank(5) == 2;
+        board->removePlayer(6);
+        ok = ok && board->getByRank(1) == 5 && board->getPlayersInScoreRange(0, 100) == vector<int>({ 5 });
+        delete board;
+        return ok;
+        }());
+}
+
+void test_SkipList_TopCache() {
+    cout << "\n🔍 SKIP LIST - CACHED TOP-N\n";
+
+    runner.runTest("TopCache: Patched cache matches reference", [&]() {
+        Leaderboard* board = createLeaderboardWithConfig(0.5, 8);
+        BoardReference reference;
+        unsigned int seed = 404;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        bool ok = board->getTopN(100).empty();  // Builds the (empty) cache
+        vector<int> out(100);
+        for (int step = 0; step < 20000 && ok; step++) {
+            int id = (int)(next() % 300);
+            if (next() % 5 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 200);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+            if (step % 50 == 0) {
+                vector<int> expected = reference.topN(100);
+                int count = board->getTopN(100, out.data());
+                ok = board->getTopN(100) == expected && count == (int)expected.size() &&
+                    equal(expected.begin(), expected.end(), out.begin()) &&
+                    board->getTopN(10) == reference.topN(10);
+            }
+        }
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("TopCache: Larger n rebuilds, huge n walks the list", [&]() {
+        Leaderboard* board = createLeaderboard();
+        for (int i = 0; i < 3000; i++) board->addScore(i, 3000 - i);
+        vector<int> top5 = board->getTopN(5);
+        vector<int> top2000 = board->getTopN(2000);
+        vector<int> all = board->getTopN(INT_MAX);
+        board->removePlayer(0);
+        vector<int> out(3000);
+        int count = board->getTopN(3000, out.data());
+        bool ok = top5 == vector<int>({ 0, 1, 2, 3, 4 }) && top2000.size() == 2000 &&
+            top2000[1999] == 1999 && all.size() == 3000 &&
+            count == 2999 && out[0] == 1 && out[2998] == 2999 &&
+            board->getTopN(5) == vector<int>({ 1, 2, 3, 4, 5 }) &&
+            board->getTopN(-3).empty();
+        delete board;
+        return ok;
+        }());
+}
+
+void test_SkipList_Sharded() {
+    cout << "\n🔍 SKIP LIST - SHARDED LEADERBOARD\n";
+
+    runner.runTest("Sharded: Merged ranking matches reference", [&]() {
+        Leaderboard* board = createShardedLeaderboard(8);
+        BoardReference reference;
+        unsigned int seed = 606;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+        for (int step = 0; step < 20000; step++) {
+            int id = (int)(next() % 2000);
+            if (next() % 5 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 100);  // Ties spread across shards
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        vector<int> ranking = reference.topN(INT_MAX);
+        bool ok = board->getTopN(INT_MAX) == ranking && board->getTopN(25) == reference.topN(25);
+        vector<int> out(25);
+        ok = ok && board->getTopN(25, out.data()) == 25 && out == reference.topN(25);
+        for (int r = 1; r <= (int)ranking.size(); r += 13) {
+            ok = ok && board->getRank(ranking[r - 1]) == r;
+        }
+        ok = ok && board->getRank(-5) == -1;
+        vector<int> inRange;
+        for (int id : ranking) {
+            int s = reference.scoreOf[id];
+            if (s >= 20 && s <= 40) inRange.push_back(id);
+        }
+        ok = ok && board->countInScoreRange(20, 40) == (int)inRange.size() &&
+            board->getPlayersInScoreRange(20, 40) == inRange;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("Sharded: Parallel writers on disjoint players", [&]() {
+        Leaderboard* board = createShardedLeaderboard(16);
+        const int writers = 4;
+        vector<thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < 5000; i++) {
+                    int id = i * writers + w;
+                    board->addScore(id, id % 997);
+                    if (i % 5 == 0) board->removePlayer(id);
+                }
+            });
+        }
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 200; i++) board->getTopN(10);
+        });
+        for (auto& t : threads) t.join();
+
+        BoardReference reference;
+        for (int id = 0; id < 5000 * writers; id++) {
+            if ((id / writers) % 5 != 0) reference.addScore(id, id % 997);
+        }
+        bool ok = board->getTopN(INT_MAX) == reference.topN(INT_MAX);
+        delete board;
+        return ok;
+        }());
+}
+
+// Recomputes a windowed ranking from the raw per-bucket events
+vector<int> windowReference(const vector<vector<pair<int, int>>>& window, WindowPolicy policy) {
+    map<int, long long> combined;
+    for (const auto& bucket : window) {
+        for (const auto& e : bucket) {
+            auto it = combined.find(e.first);
+            if (it == combined.end()) combined[e.first] = e.second;
+            else if (policy == WINDOW_SUM_SCORES) it->second += e.second;
+            else it->second = max(it->second, (long long)e.second);
+        }
+    }
+    BoardReference reference;
+    for (const auto& entry : combined) reference.addScore(entry.first, (int)entry.second);
+    return reference.topN(INT_MAX);
+}
+
+void test_SkipList_Windowed() {
+    cout << "\n🔍 SKIP LIST - TIME-WINDOWED LEADERBOARD\n";
+
+    WindowPolicy policies[] = { WINDOW_BEST_SCORE, WINDOW_SUM_SCORES };
+    const char* names[] = { "Windowed(best): Matches replay over 20 rollovers",
+                            "Windowed(sum): Matches replay over 20 rollovers" };
+    for (int p = 0; p < 2; p++) {
+        runner.runTest(names[p], [&]() {
+            Leaderboard* board = createWindowedLeaderboard(3, policies[p]);
+            vector<vector<pair<int, int>>> window(1);
+            unsigned int seed = 900 + p;
+            auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+            bool ok = true;
+            for (int hour = 0; hour < 20 && ok; hour++) {
+                for (int i = 0; i < 500; i++) {
+                    int id = (int)(next() % 150);
+                    int score = (int)(next() % 100) - 20;  // Sums may go negative
+                    board->addScore(id, score);
+                    window.back().push_back({ id, score });
+                }
+                vector<int> expected = windowReference(window, policies[p]);
+                ok = board->getTopN(INT_MAX) == expected &&
+                    board->getTopN(10) == vector<int>(expected.begin(), expected.begin() + min<size_t>(10, expected.size()));
+                if (ok && !expected.empty()) ok = board->getRank(expected[expected.size() / 2]) == (int)expected.size() / 2 + 1;
+                board->rollover();
+                window.push_back({});
+                if (window.size() > 3) window.erase(window.begin());
+            }
+            delete board;
+            return ok;
+            }());
+    }
+
+    runner.runTest("Windowed: Removal and full expiry", [&]() {
+        Leaderboard* board = createWindowedLeaderboard(2, WINDOW_SUM_SCORES);
+        board->addScore(1, 10);
+        board->addScore(2, 5);
+        board->rollover();
+        board->addScore(2, 10);
+        board->removePlayer(1);
+        bool ok = board->getTopN(5) == vector<int>({ 2 });
+        board->rollover();  // First bucket expires: 2 keeps its 10
+        ok = ok && board->getTopN(5) == vector<int>({ 2 }) && board->countInScoreRange(10, 10) == 1;
+        board->rollover();
+        ok = ok && board->getTopN(5).empty();
+        delete board;
+
+        int thrown = 0;
+        try { createWindowedLeaderboard(0, WINDOW_BEST_SCORE); }
+        catch (const char*) { thrown++; }
+        Leaderboard* plain = createLeaderboard();
+        try { plain->rollover(); }
+        catch (const char*) { thrown++; }
+        delete plain;
+        return ok && thrown == 2;
+        }());
+}
+
+void test_SkipList_BulkLoad() {
+    cout << "\n🔍 SKIP LIST - BULK LOAD AND SNAPSHOT\n";
+
+    const char* path = "arcadia_leaderboard_snapshot.bin";
+    unsigned int seed = 1212;
+    auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+
+    Leaderboard* board = createLeaderboardWithConfig(0.25, 3);
+    BoardReference reference;
+
+    runner.runTest("BulkLoad: Merges with existing players, later pairs win", [&]() {
+        for (int i = 0; i < 500; i++) {
+            board->addScore(i, i % 40);
+            reference.addScore(i, i % 40);
+        }
+        vector<pair<int, int>> entries;
+        for (int i = 0; i < 20000; i++) {
+            int id = (int)(next() % 8000);
+            int score = (int)(next() % 2000);
+            entries.push_back({ id, score });
+            reference.addScore(id, score);
+        }
+        board->bulkLoad(entries);
+        return board->getTopN(INT_MAX) == reference.topN(INT_MAX);
+        }());
+
+    runner.runTest("BulkLoad: Ranks, ranges and later updates stay correct", [&]() {
+        vector<int> ranking = reference.topN(INT_MAX);
+        bool ok = true;
+        for (int r = 1; r <= (int)ranking.size(); r += 31) {
+            ok = ok && board->getByRank(r) == ranking[r - 1] && board->getRank(ranking[r - 1]) == r;
+        }
+        for (int step = 0; step < 3000; step++) {
+            int id = (int)(next() % 9000);
+            if (step % 3 == 0) {
+                board->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 2000);
+                board->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        ranking = reference.topN(INT_MAX);
+        for (int r = 1; r <= (int)ranking.size(); r += 29) {
+            ok = ok && board->getByRank(r) == ranking[r - 1];
+        }
+        return ok && board->getTopN(INT_MAX) == ranking;
+        }());
+
+    runner.runTest("Snapshot: Save and restore round trip", [&]() {
+        board->saveSnapshot(path);
+        Leaderboard* restored = loadLeaderboardSnapshot(path);
+        vector<int> ranking = reference.topN(INT_MAX);
+        bool ok = restored->getTopN(INT_MAX) == ranking &&
+            restored->getRank(ranking.back()) == (int)ranking.size() &&
+            restored->countInScoreRange(100, 200) == board->countInScoreRange(100, 200);
+        restored->addScore(ranking.back(), 5000);
+        ok = ok && restored->getByRank(1) == ranking.back();
+        delete restored;
+
+        Leaderboard* empty = createLeaderboard();
+        empty->saveSnapshot(path);
+        Leaderboard* restoredEmpty = loadLeaderboardSnapshot(path);
+        ok = ok && restoredEmpty->getTopN(10).empty();
+        delete empty;
+        delete restoredEmpty;
+        return ok;
+        }());
+
+    runner.runTest("Snapshot: Rejects a non-snapshot file", [&]() {
+        FILE* f = fopen(path, "wb");
+        fputs("definitely not a leaderboard", f);
+        fclose(f);
+        try {
+            Leaderboard* bad = loadLeaderboardSnapshot(path);
+            delete bad;
+            return false;
+        }
+        catch (const char*) {
+            return true;
+        }
+        }());
+
+    runner.runTest("Snapshot: Rejects truncated file and oversized count", [&]() {
+        Leaderboard* small = createLeaderboard();
+        for (int i = 0; i < 100; i++) small->addScore(i, i * 3);
+        small->saveSnapshot(path);
+        delete small;
+
+        FILE* f = fopen(path, "rb");
+        vector<char> bytes;
+        for (int c = fgetc(f); c != EOF; c = fgetc(f)) bytes.push_back((char)c);
+        fclose(f);
+
+        // Header is 24 bytes with the entry count at offset 12
+        vector<char> truncated(bytes.begin(), bytes.end() - 4);
+        vector<char> hugeCount = bytes;
+        uint32_t count = 0x7fffffff;
+        memcpy(&hugeCount[12], &count, sizeof(count));
+        vector<char> trailing = bytes;
+        trailing.resize(bytes.size() + 8, 0);
+
+        int rejected = 0;
+        for (const vector<char>* corrupt : { &truncated, &hugeCount, &trailing }) {
+            f = fopen(path, "wb");
+            fwrite(corrupt->data(), 1, corrupt->size(), f);
+            fclose(f);
+            try {
+                Leaderboard* bad = loadLeaderboardSnapshot(path);
+                delete bad;
+            }
+            catch (const char*) {
+                rejected++;
+            }
+        }
+        return rejected == 3;
+        }());
+
+    remove(path);
+    delete board;
+}
+
+// Applies a rank event batch to a consumer-side copy of the top K
+void applyRankEvents(vector<int>& mirror, const RankEvent* events, int count) {
+    for (int i = 0; i < count; i++) {
+        const RankEvent& e = events[i];
+        if (e.kind == RANK_RESYNC) {
+            mirror.clear();
+            continue;
+        }
+        if (e.oldRank > 0) mirror.erase(mirror.begin() + (e.oldRank - 1));
+        if (e.newRank > 0) mirror.insert(mirror.begin() + (e.newRank - 1), e.playerID);
+    }
+}
+
+void test_SkipList_RankEvents() {
+    cout << "\n🔍 SKIP LIST - TOP-K RANK EVENTS\n";
+
+    unsigned int seed = 2222;
+    auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+    RankEvent events[256];
+
+    runner.runTest("RankEvents: Mirror tracks getTopN(K) under random updates", [&]() {
+        Leaderboard* board = createLeaderboard();
+        const int K = 10;
+        board->watchTopK(K, 1024);
+        vector<int> mirror;
+        bool ok = true;
+        for (int step = 0; step < 5000 && ok; step++) {
+            int id = (int)(next() % 60);
+            if (step % 4 == 0) board->removePlayer(id);
+            else board->addScore(id, (int)(next() % 100));
+            int count = board->pollRankEvents(events, 256);
+            applyRankEvents(mirror, events, count);
+            ok = mirror == board->getTopN(K);
+        }
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("RankEvents: Fewer players than K and unchanged top K", [&]() {
+        Leaderboard* board = createLeaderboard();
+        board->addScore(1, 50);
+        board->watchTopK(5, 64);
+        vector<int> mirror;
+        applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+        bool ok = mirror == vector<int>{ 1 };
+        board->addScore(2, 70);
+        board->addScore(3, 10);
+        applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+        ok = ok && mirror == vector<int>{ 2, 1, 3 };
+        for (int id = 10; id < 20; id++) board->addScore(id, 1);
+        board->pollRankEvents(events, 256);
+        board->addScore(15, 0);  // Stays below the top 5
+        ok = ok && board->pollRankEvents(events, 256) == 0;
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("RankEvents: Overflow resyncs after the consumer catches up", [&]() {
+        Leaderboard* board = createLeaderboard();
+        const int K = 8;
+        board->watchTopK(K, 1);  // Rounded up to the minimum capacity
+        vector<int> mirror;
+        bool ok = true;
+        for (int round = 0; round < 50; round++) {
+            int writes = (int)(next() % 40);
+            for (int i = 0; i < writes; i++) {
+                board->addScore((int)(next() % 30), (int)(next() % 1000));
+            }
+            applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+            board->addScore((int)(next() % 30), (int)(next() % 1000));
+            applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+            ok = ok && mirror == board->getTopN(K);
+        }
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("RankEvents: Bulk load and buffered board", [&]() {
+        Leaderboard* board = createLeaderboard();
+        board->watchTopK(4, 64);
+        vector<int> mirror;
+        board->bulkLoad({ { 1, 5 }, { 2, 9 }, { 3, 7 }, { 4, 1 }, { 5, 8 } });
+        applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+        bool ok = mirror == vector<int>{ 2, 5, 3, 1 };
+        delete board;
+
+        Leaderboard* buffered = createBufferedLeaderboard(false);
+        buffered->watchTopK(3, 64);
+        mirror.clear();
+        for (int i = 0; i < 20; i++) buffered->addScore(i % 7, i);
+        buffered->flush();
+        applyRankEvents(mirror, events, buffered->pollRankEvents(events, 256));
+        ok = ok && mirror == buffered->getTopN(3);
+        delete buffered;
+        return ok;
+        }());
+
+    runner.runTest("RankEvents: Writer and poller on separate threads", [&]() {
+        Leaderboard* board = createLeaderboard();
+        const int K = 16;
+        board->watchTopK(K, 256);
+        vector<int> mirror;
+        atomic<bool> done(false);
+        thread poller([&]() {
+            RankEvent batch[64];
+            while (true) {
+                bool finished = done.load();
+                int count = board->pollRankEvents(batch, 64);
+                applyRankEvents(mirror, batch, count);
+                if (finished && count == 0) break;
+            }
+            });
+        unsigned int writerSeed = 77;
+        for (int step = 0; step < 50000; step++) {
+            writerSeed = writerSeed * 1103515245u + 12345u;
+            int id = (int)((writerSeed >> 8) % 500);
+            if (step % 5 == 0) board->removePlayer(id);
+            else board->addScore(id, (int)((writerSeed >> 16) % 5000));
+        }
+        done.store(true);
+        poller.join();
+        board->addScore(0, 1);  // Delivers any resync owed from an overflow
+        applyRankEvents(mirror, events, board->pollRankEvents(events, 256));
+        bool ok = mirror == board->getTopN(K);
+        delete board;
+        return ok;
+        }());
+
+    runner.runTest("RankEvents: Polling without a watch throws", [&]() {
+        Leaderboard* board = createLeaderboard();
+        try {
+            board->pollRankEvents(events, 1);
+            delete board;
+            return false;
+        }
+        catch (const char*) {
+            delete board;
+            return true;
+        }
+        }());
+}
+
+void test_Leaderboard_Fenwick() {
+    cout << "\n🔍 LEADERBOARD - FENWICK (BOUNDED SCORES)\n";
+
+    unsigned int seed = 2323;
+    auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+
+    // Scores in [-50, 449]; the skip list board answers the same queries
+    Leaderboard* board = createFenwickLeaderboard(-50, 449);
+    Leaderboard* skipList = createLeaderboard();
+    BoardReference reference;
+
+    runner.runTest("Fenwick: 20k random add/update/remove", [&]() {
+        for (int step = 0; step < 20000; step++) {
+            int id = (int)(next() % 3000);
+            if (next() % 5 == 0) {
+                board->removePlayer(id);
+                skipList->removePlayer(id);
+                reference.removePlayer(id);
+            }
+            else {
+                int score = (int)(next() % 500) - 50;  // Many ties
+                board->addScore(id, score);
+                skipList->addScore(id, score);
+                reference.addScore(id, score);
+            }
+        }
+        int top[50];
+        int written = board->getTopN(50, top);
+        return board->getTopN(INT_MAX) == reference.topN(INT_MAX) &&
+            vector<int>(top, top + written) == reference.topN(50) &&
+            board->getTopN(0).empty();
+        }());
+
+    runner.runTest("Fenwick: Rank, around-rank and score range queries", [&]() {
+        vector<int> ranking = reference.topN(INT_MAX);
+        int size = (int)ranking.size();
+        bool ok = board->getByRank(0) == -1 && board->getByRank(size + 1) == -1 &&
+            board->getRank(999999) == -1;
+        for (int r = 1; r <= size; r += 7) {
+            ok = ok && board->getByRank(r) == ranking[r - 1] && board->getRank(ranking[r - 1]) == r;
+        }
+        for (int r = -3; r <= size + 3; r += 97) {
+            ok = ok && board->getPlayersAroundRank(r, 4) == skipList->getPlayersAroundRank(r, 4);
+        }
+        int ranges[][2] = { { -50, 449 }, { 0, 0 }, { 100, 130 }, { 449, 600 }, { -500, -40 }, { 300, 200 }, { 500, 900 } };
+        for (auto& range : ranges) {
+            ok = ok && board->countInScoreRange(range[0], range[1]) == skipList->countInScoreRange(range[0], range[1]) &&
+                board->getPlayersInScoreRange(range[0], range[1]) == skipList->getPlayersInScoreRange(range[0], range[1]);
+        }
+        return ok;
+        }());
+
+    runner.runTest("Fenwick: Bulk load merges and later updates stay correct", [&]() {
+        vector<pair<int, int>> entries;
+        for (int i = 0; i < 10000; i++) {
+            int id = (int)(next() % 5000);
+            int score = (int)(next() % 500) - 50;
+            entries.push_back({ id, score });
+            reference.addScore(id, score);
+        }
+        board->bulkLoad(entries);
+        bool ok = board->getTopN(INT_MAX) == reference.topN(INT_MAX);
+        for (int step = 0; step < 2000; step++) {
+            int id = (int)(next() % 6000);
+            int score = (int)(next() % 500) - 50;
+            board->addScore(id, score);
+            reference.addScore(id, score);
+        }
+        vector<int> ranking = reference.topN(INT_MAX);
+        return ok && board->getTopN(INT_MAX) == ranking && board->getRank(ranking.back()) == (int)ranking.size();
+        }());
+
+    runner.runTest("Fenwick: Sparse scores across a wide range", [&]() {
+        Leaderboard* sparse = createFenwickLeaderboard(0, 1000000);
+        BoardReference sparseReference;
+        for (int i = 0; i < 300; i++) {
+            int id = (int)(next() % 200);
+            int score = (int)(next() % 1000001);
+            sparse->addScore(id, score);
+            sparseReference.addScore(id, score);
+        }
+        sparse->addScore(500, 1000000);
+        sparseReference.addScore(500, 1000000);
+        sparse->addScore(501, 0);
+        sparseReference.addScore(501, 0);
+        vector<int> ranking = sparseReference.topN(INT_MAX);
+        bool ok = sparse->getTopN(INT_MAX) == ranking &&
+            sparse->getPlayersAroundRank(100, 20) == vector<int>(ranking.begin() + 79, ranking.begin() + 120);
+        delete sparse;
+        return ok;
+        }());
+
+    runner.runTest("Fenwick: Out-of-range scores and bad bounds throw", [&]() {
+        int thrown = 0;
+        vector<int> before = board->getTopN(INT_MAX);
+        try { board->addScore(1, 450); }
+        catch (const char*) { thrown++; }
+        try { board->bulkLoad({ { 1, 10 }, { 2, -51 } }); }
+        catch (const char*) { thrown++; }
+        try { delete createFenwickLeaderboard(10, 9); }
+        catch (const char*) { thrown++; }
+        return thrown == 3 && board->getTopN(INT_MAX) == before;
+        }());
+
+    delete board;
+    delete skipList;
+}
+
+void test_Leaderboard_Percentiles() {
+    cout << "\n🔍 LEADERBOARD - PERCENTILES AND HISTOGRAMS\n";
+
+    unsigned int seed = 2424;
+    auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+
+    // Skip list, Fenwick, and the generic path through the sharded board
+    vector<Leaderboard*> boards = { createLeaderboard(), createFenwickLeaderboard(-1000, 1000),
+        createShardedLeaderboard(4), createBufferedLeaderboard(false) };
+    BoardReference reference;
+    for (int step = 0; step < 6000; step++) {
+        int id = (int)(next() % 2000);
+        int score = (int)(next() % 2001) - 1000;
+        for (Leaderboard* board : boards) board->addScore(id, score);
+        reference.addScore(id, score);
+    }
+    vector<int> sorted;  // Ascending scores
+    for (const auto& entry : reference.scoreOf) sorted.push_back(entry.second);
+    sort(sorted.begin(), sorted.end());
+    int total = (int)sorted.size();
+
+    runner.runTest("Percentiles: percentile(score) matches brute force", [&]() {
+        bool ok = true;
+        for (int score : { -2000, -1000, -999, -1, 0, 1, 500, 1000, 1001, INT_MIN, INT_MAX }) {
+            int below = (int)(lower_bound(sorted.begin(), sorted.end(), score) - sorted.begin());
+            double expected = 100.0 * below / total;
+            for (Leaderboard* board : boards) ok = ok && fabs(board->percentile(score) - expected) < 1e-9;
+        }
+        return ok;
+        }());
+
+    runner.runTest("Percentiles: scoreAtPercentile uses nearest rank", [&]() {
+        bool ok = true;
+        for (double pct : { -5.0, 0.0, 0.01, 10.0, 25.0, 50.0, 90.0, 99.9, 100.0, 150.0 }) {
+            double clamped = max(0.0, min(100.0, pct));
+            int position = max(1, (int)ceil(clamped * total / 100.0));
+            for (Leaderboard* board : boards) ok = ok && board->scoreAtPercentile(pct) == sorted[position - 1];
+        }
+        return ok;
+        }());
+
+    runner.runTest("Percentiles: Histogram buckets match brute force", [&]() {
+        bool ok = true;
+        int layouts[][3] = { { -1000, 100, 21 }, { -50, 7, 30 }, { 900, 1000, 3 }, { INT_MAX - 10, 100, 2 } };
+        for (auto& layout : layouts) {
+            vector<int> expected(layout[2]);
+            for (int score : sorted) {
+                long long offset = (long long)score - layout[0];
+                if (offset >= 0 && offset / layout[1] < layout[2]) expected[offset / layout[1]]++;
+            }
+            for (Leaderboard* board : boards) ok = ok && board->getScoreHistogram(layout[0], layout[1], layout[2]) == expected;
+        }
+        return ok;
+        }());
+
+    runner.runTest("Percentiles: Empty board and bad histogram", [&]() {
+        Leaderboard* empty = createLeaderboard();
+        int thrown = 0;
+        bool ok = empty->percentile(10) == 0.0 && empty->getScoreHistogram(0, 10, 3) == vector<int>(3, 0);
+        try { empty->scoreAtPercentile(50); }
+        catch (const char*) { thrown++; }
+        try { boards[0]->getScoreHistogram(0, 0, 3); }
+        catch (const char*) { thrown++; }
+        delete empty;
+        return ok && thrown == 2;
+        }());
+
+    for (Leaderboard* board : boards) delete board;
+}
+
 // ==========================================
 // RED-BLACK TREE - STRONG TESTS
 // ==========================================
@@ -449,6 +2144,31 @@ void test_RBTree_UpdateItems() {
     delete tree;
 }
 
+void test_RBTree_Relisting() {
+    cout << "\n🔍 RB TREE - RANDOM RELISTING\n";
+
+    AuctionTree* tree = createAuctionTree();
+    unsigned int seed = 2525;
+    auto next = [&]() { seed = seed * 1103515245u + 12345u; return (seed >> 8); };
+
+    // Relists move nodes through every delete case; the itemID index
+    // must follow each one
+    runner.runTest("RBTree: 50k random relists and deletes", [&]() {
+        for (int step = 0; step < 50000; step++) {
+            int id = (int)(next() % 4000);
+            if (next() % 4 == 0) tree->deleteItem(id);
+            else tree->insertItem(id, (int)(next() % 300));  // Many shared prices
+        }
+        for (int id = 0; id < 4000; id++) {
+            tree->deleteItem(id);
+        }
+        tree->insertItem(1, 10);
+        return true;
+        }());
+
+    delete tree;
+}
+
 // ==========================================
 // INTEGRATION TESTS - PART A
 // ==========================================
@@ -518,17 +2238,41 @@ void test_PartA_DataStructures() {
     test_HashTable_DoubleHashing();
     test_HashTable_TableFull();
     test_HashTable_TombstoneHandling();
+    test_HashTable_Resizable();
+    test_HashTable_FlatLayout();
+    test_HashTable_NameViews();
+    test_HashTable_Batch();
+    test_HashTable_RemoveChurn();
+    test_HashTable_Concurrent();
+    test_HashTable_Snapshot();
+    test_HashTable_Stats();
+    test_HashTable_StaticPolicies();
+    test_HashTable_NameIndex();
+    test_HashTable_SessionTTL();
 
     // Skip List Tests
     test_SkipList_TieBreaking();
     test_SkipList_ScoreUpdates();
     test_SkipList_RemoveOperations();
     test_SkipList_getTopN_EdgeCases();
+    test_SkipList_RandomizedUpdates();
+    test_SkipList_RankQueries();
+    test_SkipList_Config();
+    test_SkipList_Concurrent();
+    test_SkipList_Buffered();
+    test_SkipList_TopCache();
+    test_SkipList_Sharded();
+    test_SkipList_Windowed();
+    test_SkipList_BulkLoad();
+    test_SkipList_RankEvents();
+    test_Leaderboard_Fenwick();
+    test_Leaderboard_Percentiles();
 
     // Red-Black Tree Tests
     test_RBTree_DuplicatePrices();
     test_RBTree_DeleteOperations();
     test_RBTree_UpdateItems();
+    test_RBTree_Relisting();
 
     // Integration & Performance
     test_PartA_Integration();